@@ -0,0 +1,85 @@
+// Headless benchmark for the chunk save codec: generates terrain chunks and
+// reports encoded size and encode/decode throughput for each payload format.
+//
+// Usage: chunk_codec_benchmark [seed] [radius in chunks]
+
+#include "World/ChunkCodec.h"
+#include "World/WorldGenerator.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+struct Result {
+    const char* name;
+    size_t bytes = 0;
+    double encodeSeconds = 0.0;
+    double decodeSeconds = 0.0;
+    bool ok = true;
+};
+
+void measure(Result& result, const std::vector<std::vector<Block>>& chunks, int mode) {
+    std::vector<u8> payload;
+    std::vector<Block> decoded(CHUNK_VOLUME);
+
+    for (const auto& blocks : chunks) {
+        auto t0 = Clock::now();
+        if (mode == 1) {
+            payload.resize(CHUNK_VOLUME * sizeof(Block));
+            std::memcpy(payload.data(), blocks.data(), payload.size());
+        } else {
+            ChunkCodec::encode(blocks.data(), payload, mode == 3);
+        }
+        auto t1 = Clock::now();
+        bool decodedOk = ChunkCodec::decode(payload, decoded.data());
+        auto t2 = Clock::now();
+
+        result.encodeSeconds += std::chrono::duration<double>(t1 - t0).count();
+        result.decodeSeconds += std::chrono::duration<double>(t2 - t1).count();
+        result.bytes += payload.size();
+        result.ok = result.ok && decodedOk && std::memcmp(decoded.data(), blocks.data(), CHUNK_VOLUME * sizeof(Block)) == 0;
+    }
+}
+}
+
+int main(int argc, char** argv) {
+    unsigned int seed = argc > 1 ? static_cast<unsigned int>(std::strtoul(argv[1], nullptr, 10)) : 12345;
+    int radius = argc > 2 ? std::atoi(argv[2]) : 4;
+
+    WorldGenerator generator(seed);
+    std::vector<std::vector<Block>> chunks;
+    for (int x = -radius; x <= radius; ++x) {
+        for (int z = -radius; z <= radius; ++z) {
+            for (int y = -4; y <= 12; ++y) {
+                auto chunk = std::make_shared<Chunk>(ChunkPos(x, y, z));
+                generator.generate(chunk);
+                chunks.emplace_back(CHUNK_VOLUME);
+                chunk->copyBlocks(chunks.back().data());
+            }
+        }
+    }
+
+    Result results[] = {{"v1 raw"}, {"v2 palette+RLE"}, {"v2 palette+RLE+LZ"}};
+    for (int i = 0; i < 3; ++i) {
+        measure(results[i], chunks, i + 1);
+    }
+
+    double rawMB = static_cast<double>(chunks.size()) * CHUNK_VOLUME * sizeof(Block) / (1024.0 * 1024.0);
+    std::printf("%zu chunks (seed %u), %.1f MB raw\n", chunks.size(), seed, rawMB);
+    std::printf("%-20s %12s %8s %14s %14s\n", "format", "bytes/chunk", "ratio", "encode MB/s", "decode MB/s");
+    bool ok = true;
+    for (const Result& r : results) {
+        double perChunk = static_cast<double>(r.bytes) / chunks.size();
+        std::printf("%-20s %12.1f %7.1fx %14.1f %14.1f%s\n", r.name, perChunk,
+                    CHUNK_VOLUME * sizeof(Block) / perChunk,
+                    rawMB / r.encodeSeconds, rawMB / r.decodeSeconds,
+                    r.ok ? "" : "  ROUND TRIP FAILED");
+        ok = ok && r.ok;
+    }
+    return ok ? 0 : 1;
+}
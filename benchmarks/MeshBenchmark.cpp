@@ -0,0 +1,252 @@
+// Headless benchmark for MeshBuilder: meshes synthetic worst cases and generated
+// terrain with every meshing algorithm and LOD, and reports throughput, mesh size
+// and heap allocations per chunk.
+//
+// Usage: mesh_benchmark [--csv] [--passes N] [--radius R] [seed ...]
+//   --csv     one machine-readable row per run (header first) instead of the table
+//   --passes  timed passes over every scenario after one warm-up pass (default 3)
+//   --radius  scenario size in chunks around the origin (default 4, at least 3)
+//   seeds     WorldGenerator seeds for the terrain scenarios (default 12345)
+
+#include "Mesh/MeshBuilder.h"
+#include "World/WorldGenerator.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <new>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+std::atomic<u64> allocations{0};
+}
+
+// Counts every heap allocation of the process; the benchmark is single-threaded
+void* operator new(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+// Chunks of a scenario and the ones that get meshed (all with a full neighborhood)
+struct Scenario {
+    std::string name;
+    std::unordered_map<ChunkPos, std::shared_ptr<Chunk>> chunks;
+    std::vector<ChunkPos> meshed;
+};
+
+struct Run {
+    std::string scenario;
+    const char* algorithm;
+    int lod;
+    size_t chunks = 0;       // Meshed chunks over all timed passes
+    double seconds = 0.0;
+    u64 vertices = 0;
+    u64 waterVertices = 0;
+    u64 allocations = 0;
+};
+
+// Deterministic per-block hash for the synthetic patterns
+u32 hashBlock(int x, int y, int z) {
+    u32 h = static_cast<u32>(x) * 73856093u ^ static_cast<u32>(y) * 19349663u ^ static_cast<u32>(z) * 83492791u;
+    h ^= h >> 13;
+    h *= 0x5bd1e995u;
+    return h ^ (h >> 15);
+}
+
+// Fills chunks x/z in [-radius - 1, radius + 1], y in [minY - 1, maxY + 1] from a world-space
+// pattern and meshes the inner ones
+Scenario makeSynthetic(const std::string& name, int radius, int minY, int maxY,
+                       const std::function<Block(int, int, int)>& pattern) {
+    Scenario scenario;
+    scenario.name = name;
+    std::vector<Block> blocks(CHUNK_VOLUME);
+    for (int cy = minY - 1; cy <= maxY + 1; ++cy) {
+        for (int cz = -radius - 1; cz <= radius + 1; ++cz) {
+            for (int cx = -radius - 1; cx <= radius + 1; ++cx) {
+                ChunkPos pos(cx, cy, cz);
+                for (int y = 0; y < CHUNK_HEIGHT; ++y) {
+                    for (int z = 0; z < CHUNK_SIZE; ++z) {
+                        for (int x = 0; x < CHUNK_SIZE; ++x) {
+                            blocks[y * CHUNK_AREA + z * CHUNK_SIZE + x] =
+                                pattern(cx * CHUNK_SIZE + x, cy * CHUNK_HEIGHT + y, cz * CHUNK_SIZE + z);
+                        }
+                    }
+                }
+                auto chunk = std::make_shared<Chunk>(pos);
+                chunk->setBlocks(blocks.data());
+                scenario.chunks[pos] = chunk;
+
+                bool inner = cy >= minY && cy <= maxY && std::abs(cx) <= radius && std::abs(cz) <= radius;
+                if (inner) scenario.meshed.push_back(pos);
+            }
+        }
+    }
+    return scenario;
+}
+
+Scenario makeTerrain(unsigned int seed, int radius) {
+    Scenario scenario;
+    scenario.name = "terrain-" + std::to_string(seed);
+    WorldGenerator generator(seed);
+    for (int cy = -4; cy <= 12; ++cy) {
+        for (int cz = -radius - 1; cz <= radius + 1; ++cz) {
+            for (int cx = -radius - 1; cx <= radius + 1; ++cx) {
+                ChunkPos pos(cx, cy, cz);
+                auto chunk = std::make_shared<Chunk>(pos);
+                generator.generate(chunk);
+                scenario.chunks[pos] = chunk;
+
+                bool inner = cy > -4 && cy < 12 && std::abs(cx) <= radius && std::abs(cz) <= radius;
+                if (inner) scenario.meshed.push_back(pos);
+            }
+        }
+    }
+    return scenario;
+}
+
+ChunkNeighborhood neighborhoodOf(const Scenario& scenario, const ChunkPos& pos) {
+    ChunkNeighborhood neighborhood{};
+    for (int dy = -1; dy <= 1; ++dy) {
+        for (int dz = -1; dz <= 1; ++dz) {
+            for (int dx = -1; dx <= 1; ++dx) {
+                auto it = scenario.chunks.find(pos + ChunkPos(dx, dy, dz));
+                if (it != scenario.chunks.end()) neighborhood[(dy + 1) * 9 + (dz + 1) * 3 + (dx + 1)] = it->second;
+            }
+        }
+    }
+    return neighborhood;
+}
+
+// One warm-up pass (fills the buffer pool and size hints), then the timed passes.
+// Every scenario meshes more than MESH_CACHE_SIZE chunks in a fixed order, so each
+// LOD 0 build misses the incremental cache and is a full re-mesh.
+Run measure(const Scenario& scenario, MeshingAlgorithm algorithm, int lod, int passes) {
+    Run run{scenario.name, algorithm == MeshingAlgorithm::BINARY ? "binary" : "greedy", lod};
+    for (const auto& [pos, chunk] : scenario.chunks) {
+        chunk->setCurrentLOD(lod);
+    }
+
+    std::vector<ChunkNeighborhood> neighborhoods;
+    for (const ChunkPos& pos : scenario.meshed) {
+        neighborhoods.push_back(neighborhoodOf(scenario, pos));
+    }
+
+    MeshBuilder builder;
+    builder.setAlgorithm(algorithm);
+    for (int pass = -1; pass < passes; ++pass) {
+        for (const ChunkNeighborhood& neighborhood : neighborhoods) {
+            u64 allocationsBefore = allocations.load(std::memory_order_relaxed);
+            auto start = Clock::now();
+            MeshData meshData = builder.buildChunkMesh(neighborhood, lod);
+            double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+            u64 allocated = allocations.load(std::memory_order_relaxed) - allocationsBefore;
+
+            if (pass >= 0) {
+                run.chunks++;
+                run.seconds += elapsed;
+                run.vertices += meshData.vertices.size();
+                run.waterVertices += meshData.waterVertices.size();
+                run.allocations += allocated;
+            }
+            // As after a GPU upload
+            builder.recycle(std::move(meshData));
+        }
+    }
+    return run;
+}
+}
+
+int main(int argc, char** argv) {
+    bool csv = false;
+    int passes = 3;
+    int radius = 4;
+    std::vector<unsigned int> seeds;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--csv") == 0) {
+            csv = true;
+        } else if (std::strcmp(argv[i], "--passes") == 0 && i + 1 < argc) {
+            passes = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--radius") == 0 && i + 1 < argc) {
+            radius = std::max(3, std::atoi(argv[++i]));
+        } else {
+            seeds.push_back(static_cast<unsigned int>(std::strtoul(argv[i], nullptr, 10)));
+        }
+    }
+    if (seeds.empty()) seeds.push_back(12345);
+
+    std::vector<Scenario> scenarios;
+    // Worst case for face count: no two neighboring blocks are alike
+    scenarios.push_back(makeSynthetic("checkerboard", radius, 0, 1, [](int x, int y, int z) {
+        return ((x + y + z) & 1) ? Block(BlockType::STONE) : Block(BlockType::AIR);
+    }));
+    // Deep water with a sand floor: large transparent volumes and their surface
+    scenarios.push_back(makeSynthetic("ocean", radius, 0, 2, [](int, int y, int) {
+        if (y < 2) return Block(BlockType::SAND);
+        return y < 40 ? Block(BlockType::WATER) : Block(BlockType::AIR);
+    }));
+    // Stone riddled with tunnels: many small, irregular surfaces
+    scenarios.push_back(makeSynthetic("caves", radius, 0, 2, [](int x, int y, int z) {
+        float density = std::sin(x * 0.31f) + std::sin(y * 0.27f + z * 0.11f) + std::sin(z * 0.37f - x * 0.13f);
+        return density > -0.4f ? Block(BlockType::STONE) : Block(BlockType::AIR);
+    }));
+    // Grass with plants on top and a sparse leaf canopy: cross models and leaf faces
+    scenarios.push_back(makeSynthetic("foliage", radius, 0, 1, [](int x, int y, int z) {
+        u32 h = hashBlock(x, y, z);
+        if (y < 8) return Block(BlockType::DIRT);
+        if (y == 8) return Block(BlockType::GRASS);
+        if (y == 9) return h % 3 == 0 ? Block(BlockType::TALL_GRASS) : h % 3 == 1 ? Block(BlockType::ROSE) : Block(BlockType::AIR);
+        if (y >= 20 && y < 28) return h % 4 != 0 ? Block(BlockType::LEAVES) : Block(BlockType::AIR);
+        return (x % 6 == 0 && z % 6 == 0 && y < 20) ? Block(BlockType::LOG) : Block(BlockType::AIR);
+    }));
+    for (unsigned int seed : seeds) {
+        scenarios.push_back(makeTerrain(seed, radius));
+    }
+
+    std::vector<Run> runs;
+    for (const Scenario& scenario : scenarios) {
+        runs.push_back(measure(scenario, MeshingAlgorithm::GREEDY, 0, passes));
+        runs.push_back(measure(scenario, MeshingAlgorithm::BINARY, 0, passes));
+        // Above LOD 0 both algorithms run the same sweep
+        for (int lod = 1; lod <= CHUNK_MIP_LEVELS; ++lod) {
+            runs.push_back(measure(scenario, MeshingAlgorithm::GREEDY, lod, passes));
+        }
+    }
+
+    if (csv) {
+        std::printf("scenario,algorithm,lod,chunks,chunks_per_sec,us_per_chunk,vertices_per_chunk,"
+                    "water_vertices_per_chunk,quads_per_chunk,bytes_per_chunk,allocs_per_chunk\n");
+    } else {
+        std::printf("%d timed passes, radius %d, %zu-byte vertices\n", passes, radius, sizeof(Vertex));
+        std::printf("%-18s %-7s %3s %7s %10s %9s %10s %9s %9s %11s %8s\n", "scenario", "algo", "lod", "chunks",
+                    "chunks/s", "us/chunk", "verts", "water", "quads", "bytes", "allocs");
+    }
+    for (const Run& r : runs) {
+        double n = static_cast<double>(r.chunks);
+        double vertices = (r.vertices + r.waterVertices) / n;
+        const char* format = csv ? "%s,%s,%d,%zu,%.1f,%.2f,%.1f,%.1f,%.1f,%.1f,%.3f\n"
+                                 : "%-18s %-7s %3d %7zu %10.1f %9.2f %10.1f %9.1f %9.1f %11.1f %8.3f\n";
+        std::printf(format, r.scenario.c_str(), r.algorithm, r.lod, r.chunks, n / r.seconds, r.seconds * 1e6 / n,
+                    r.vertices / n, r.waterVertices / n, vertices / 4.0, vertices * sizeof(Vertex),
+                    r.allocations / n);
+    }
+    return 0;
+}
@@ -47,9 +47,11 @@ void main() {
     }
     
     // Disable waves for still water (Data == 0)
-    // Note: We use the lower 4 bits for level, bit 4 for "isTop"
+    // Note: We use the lower 4 bits for level, bit 4 for "isTop", bit 6 for "face is flowing".
+    // The level is per corner (shared by every face touching it), so neighbors displace alike.
     uint level = aData & 0x0Fu;
     bool isTop = (aData & 0x10u) != 0u;
+    bool isFlowing = (aData & 0x40u) != 0u;
     
     if (level == 0u) {
         wave = 0.0;
@@ -113,6 +115,7 @@ void main() {
     vMaterial = aMaterial;
     vAO = float(aAO) / 3.0;
     
-    // Pass level to fragment shader for animation control
-    vLevel = level;
+    // Pass level to fragment shader for animation control (flowing faces scroll even
+    // where a corner touches a source block)
+    vLevel = isFlowing ? max(level, 1u) : level;
 }
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+enum class JobPriority {
+    HIGH = 0,
+    NORMAL = 1,
+    LOW = 2
+};
+
+constexpr int JOB_PRIORITY_COUNT = 3;
+
+// Move-only type-erased callable with inline (small-buffer) storage.
+// Callables up to INLINE_SIZE bytes are stored in place, so submitting a job
+// doesn't allocate; larger ones fall back to the heap.
+class Job {
+public:
+    static constexpr size_t INLINE_SIZE = 128; // Fits the mesh job (static_assert in main.cpp)
+
+    Job() = default;
+
+    template<typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, Job>>>
+    Job(F&& f) {
+        using Fn = std::decay_t<F>;
+        if constexpr (fitsInline<Fn>()) {
+            new (storage) Fn(std::forward<F>(f));
+            ops = &inlineOps<Fn>;
+        } else {
+            new (storage) Fn*(new Fn(std::forward<F>(f)));
+            ops = &heapOps<Fn>;
+        }
+    }
+
+    Job(Job&& other) noexcept {
+        moveFrom(other);
+    }
+
+    Job& operator=(Job&& other) noexcept {
+        if (this != &other) {
+            reset();
+            moveFrom(other);
+        }
+        return *this;
+    }
+
+    Job(const Job&) = delete;
+    Job& operator=(const Job&) = delete;
+
+    ~Job() { reset(); }
+
+    void operator()() { ops->invoke(storage); }
+    explicit operator bool() const { return ops != nullptr; }
+
+    template<typename F>
+    static constexpr bool fitsInline() {
+        return sizeof(F) <= INLINE_SIZE && alignof(F) <= alignof(std::max_align_t) &&
+               std::is_nothrow_move_constructible_v<F>;
+    }
+
+private:
+    struct Ops {
+        void (*invoke)(void* storage);
+        void (*move)(void* dst, void* src); // Move-constructs into dst and destroys src
+        void (*destroy)(void* storage);
+    };
+
+    template<typename Fn>
+    static constexpr Ops inlineOps = {
+        [](void* s) { (*std::launder(reinterpret_cast<Fn*>(s)))(); },
+        [](void* dst, void* src) {
+            Fn* from = std::launder(reinterpret_cast<Fn*>(src));
+            new (dst) Fn(std::move(*from));
+            from->~Fn();
+        },
+        [](void* s) { std::launder(reinterpret_cast<Fn*>(s))->~Fn(); }
+    };
+
+    template<typename Fn>
+    static constexpr Ops heapOps = {
+        [](void* s) { (**std::launder(reinterpret_cast<Fn**>(s)))(); },
+        [](void* dst, void* src) { new (dst) Fn*(*std::launder(reinterpret_cast<Fn**>(src))); },
+        [](void* s) { delete *std::launder(reinterpret_cast<Fn**>(s)); }
+    };
+
+    void moveFrom(Job& other) noexcept {
+        ops = other.ops;
+        if (ops) {
+            ops->move(storage, other.storage);
+            other.ops = nullptr;
+        }
+    }
+
+    void reset() {
+        if (ops) {
+            ops->destroy(storage);
+            ops = nullptr;
+        }
+    }
+
+    alignas(std::max_align_t) unsigned char storage[INLINE_SIZE];
+    const Ops* ops = nullptr;
+};
@@ -16,6 +16,7 @@ public:
 
     // Settings variables
     int renderDistance = RENDER_DISTANCE;
+    int chunkMemoryBudgetMB = CHUNK_MEMORY_BUDGET_MB; // Blocks, meshes and unsaved edits kept resident
     float fov = FOV;
     float mouseSensitivity = MOUSE_SENSITIVITY;
     float aoStrength = 1.0f; // Multiplier for AO
@@ -30,6 +31,7 @@ public:
     bool enableTAA = false; // Disabled by default due to potential jitter/shaking artifacts
     bool enableShadows = true;
     float shadowDistance = 160.0f;
+    bool binaryMeshing = true; // Bitmask mesher at LOD 0 (same geometry as the classic greedy mesher)
     int fullscreen = 0; // 0: Windowed, 1: Fullscreen, 2: Borderless
     // Debug visualization options
     bool debugShowTAA = false; // Show TAA motion/weight overlay
@@ -60,6 +62,7 @@ public:
                 std::string value;
                 if (std::getline(is_line, value)) {
                     if (key == "renderDistance") renderDistance = std::stoi(value);
+                    else if (key == "chunkMemoryBudgetMB") chunkMemoryBudgetMB = std::stoi(value);
                     else if (key == "fov") fov = std::stof(value);
                     else if (key == "mouseSensitivity") mouseSensitivity = std::stof(value);
                     else if (key == "aoStrength") aoStrength = std::stof(value);
@@ -79,6 +82,7 @@ public:
                     else if (key == "debugShowNormals") debugShowNormals = (value == "1");
                     else if (key == "shadowDistance") shadowDistance = std::stof(value);
                     else if (key == "fullscreen") fullscreen = std::stoi(value);
+                    else if (key == "binaryMeshing") binaryMeshing = (value == "1");
                     // Keys
                     else if (key == "key_forward") keys.forward = std::stoi(value);
                     else if (key == "key_backward") keys.backward = std::stoi(value);
@@ -98,6 +102,7 @@ public:
         if (!file.is_open()) return;
         
         file << "renderDistance=" << renderDistance << "\n";
+        file << "chunkMemoryBudgetMB=" << chunkMemoryBudgetMB << "\n";
         file << "fov=" << fov << "\n";
         file << "mouseSensitivity=" << mouseSensitivity << "\n";
         file << "aoStrength=" << aoStrength << "\n";
@@ -116,6 +121,7 @@ public:
         file << "debugWireframe=" << (debugWireframe ? "1" : "0") << "\n";
         file << "debugShowNormals=" << (debugShowNormals ? "1" : "0") << "\n";
         file << "fullscreen=" << fullscreen << "\n";
+        file << "binaryMeshing=" << (binaryMeshing ? "1" : "0") << "\n";
         
         file << "key_forward=" << keys.forward << "\n";
         file << "key_backward=" << keys.backward << "\n";
@@ -1,57 +1,143 @@
 #include "ThreadPool.h"
 #include "Logger.h"
 
-ThreadPool::ThreadPool(size_t numThreads) : stop(false), activeTasks(0) {
+namespace {
+// Lets a worker push follow-up jobs onto its own deque
+thread_local const ThreadPool* currentPool = nullptr;
+thread_local size_t currentWorker = 0;
+}
+
+ThreadPool::ThreadPool(size_t numThreads)
+    : sleepingWorkers(0), queuedJobs(0), stop(false), activeTasks(0), nextQueue(0), stealCount(0) {
+    if (numThreads == 0) numThreads = 1;
+
     for (size_t i = 0; i < numThreads; ++i) {
-        workers.emplace_back([this] {
-            while (true) {
-                std::function<void()> task;
-                
-                {
-                    std::unique_lock<std::mutex> lock(this->queueMutex);
-                    this->condition.wait(lock, [this] {
-                        return this->stop || !this->tasks.empty();
-                    });
-                    
-                    if (this->stop && this->tasks.empty()) {
-                        return;
-                    }
-                    
-                    task = std::move(this->tasks.front());
-                    this->tasks.pop();
-                }
-                
-                task();
-                
-                activeTasks--;
-                completionCondition.notify_all();
-            }
-        });
+        queues.push_back(std::make_unique<WorkerQueue>());
     }
-    
+
+    for (size_t i = 0; i < numThreads; ++i) {
+        workers.emplace_back([this, i] { workerLoop(i); });
+    }
+
     LOG_INFO("ThreadPool initialized with " + std::to_string(numThreads) + " threads");
 }
 
 ThreadPool::~ThreadPool() {
     {
-        std::unique_lock<std::mutex> lock(queueMutex);
+        std::unique_lock<std::mutex> lock(sleepMutex);
         stop = true;
     }
-    
+
     condition.notify_all();
-    
+
     for (std::thread& worker : workers) {
         if (worker.joinable()) {
             worker.join();
         }
     }
-    
+
     LOG_INFO("ThreadPool destroyed");
 }
 
+void ThreadPool::push(Job&& job, JobPriority priority) {
+    if (stop) {
+        throw std::runtime_error("ThreadPool is stopped");
+    }
+
+    size_t target;
+    if (currentPool == this) {
+        target = currentWorker;
+    } else {
+        target = nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+    }
+
+    activeTasks++;
+    queuedJobs++; // Counted before the push so a popping worker never sees it go negative
+    {
+        WorkerQueue& queue = *queues[target];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs[static_cast<int>(priority)].push_back(std::move(job));
+    }
+
+    // Only touch the sleep mutex when someone is actually waiting
+    if (sleepingWorkers.load() > 0) {
+        { std::lock_guard<std::mutex> lock(sleepMutex); }
+        condition.notify_one();
+    }
+}
+
+bool ThreadPool::pop(size_t index, Job& job) {
+    const size_t count = queues.size();
+
+    for (int p = 0; p < JOB_PRIORITY_COUNT; ++p) {
+        // Own queue first (oldest job), then steal the newest job from the others
+        {
+            WorkerQueue& own = *queues[index];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            auto& jobs = own.jobs[p];
+            if (!jobs.empty()) {
+                job = std::move(jobs.front());
+                jobs.pop_front();
+                return true;
+            }
+        }
+
+        for (size_t offset = 1; offset < count; ++offset) {
+            WorkerQueue& victim = *queues[(index + offset) % count];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            auto& jobs = victim.jobs[p];
+            if (!jobs.empty()) {
+                job = std::move(jobs.back());
+                jobs.pop_back();
+                stealCount.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+void ThreadPool::workerLoop(size_t index) {
+    currentPool = this;
+    currentWorker = index;
+
+    while (true) {
+        Job job;
+        if (!pop(index, job)) {
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            sleepingWorkers++;
+            condition.wait(lock, [this] {
+                return stop || queuedJobs.load() > 0;
+            });
+            sleepingWorkers--;
+
+            if (stop && queuedJobs.load() == 0) {
+                return;
+            }
+            continue;
+        }
+
+        queuedJobs--;
+
+        try {
+            job();
+        } catch (const std::exception& e) {
+            LOG_ERROR(std::string("ThreadPool job failed: ") + e.what());
+        } catch (...) {
+            LOG_ERROR("ThreadPool job failed with unknown exception");
+        }
+
+        if (--activeTasks == 0) {
+            std::lock_guard<std::mutex> lock(completionMutex);
+            completionCondition.notify_all();
+        }
+    }
+}
+
 void ThreadPool::wait() {
-    std::unique_lock<std::mutex> lock(queueMutex);
+    std::unique_lock<std::mutex> lock(completionMutex);
     completionCondition.wait(lock, [this] {
-        return tasks.empty() && activeTasks == 0;
+        return activeTasks == 0;
     });
 }
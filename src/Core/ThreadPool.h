@@ -1,35 +1,66 @@
 #pragma once
 
+#include "Job.h"
 #include <vector>
-#include <queue>
+#include <deque>
 #include <thread>
 #include <mutex>
 #include <condition_variable>
 #include <functional>
 #include <atomic>
 #include <future>
+#include <memory>
+#include <stdexcept>
 #include <type_traits>
 
+// Work-stealing thread pool.
+// Every worker owns one deque per priority. Jobs submitted from a worker go to
+// its own deque, jobs from other threads are spread round-robin. Idle workers
+// steal from the others before going to sleep, and higher priorities are
+// always drained (locally or by stealing) before lower ones.
 class ThreadPool {
 public:
     explicit ThreadPool(size_t numThreads);
     ~ThreadPool();
 
+    // Returns a future for the result
     template<typename F, typename... Args>
     auto enqueue(F&& f, Args&&... args) -> std::future<std::invoke_result_t<F, Args...>>;
 
+    // Fire-and-forget: no future, no allocation for small callables
+    template<typename F>
+    void submit(F&& f, JobPriority priority = JobPriority::NORMAL);
+
     void wait();
     size_t getActiveTaskCount() const { return activeTasks.load(); }
+    size_t getThreadCount() const { return workers.size(); }
+    size_t getStealCount() const { return stealCount.load(std::memory_order_relaxed); }
 
 private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<Job> jobs[JOB_PRIORITY_COUNT];
+    };
+
+    void push(Job&& job, JobPriority priority);
+    bool pop(size_t index, Job& job);
+    void workerLoop(size_t index);
+
     std::vector<std::thread> workers;
-    std::queue<std::function<void()>> tasks;
-    
-    std::mutex queueMutex;
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+
+    std::mutex sleepMutex;
     std::condition_variable condition;
+    std::atomic<int> sleepingWorkers;
+    std::atomic<size_t> queuedJobs;   // Submitted, not yet picked up
+
+    std::mutex completionMutex;
     std::condition_variable completionCondition;
+
     std::atomic<bool> stop;
-    std::atomic<size_t> activeTasks;
+    std::atomic<size_t> activeTasks;  // Submitted, not yet finished
+    std::atomic<size_t> nextQueue;
+    std::atomic<size_t> stealCount;
 };
 
 template<typename F, typename... Args>
@@ -39,18 +70,13 @@ auto ThreadPool::enqueue(F&& f, Args&&... args) -> std::future<std::invoke_resul
     auto task = std::make_shared<std::packaged_task<return_type()>>(
         std::bind(std::forward<F>(f), std::forward<Args>(args)...)
     );
-    
+
     std::future<return_type> result = task->get_future();
-    
-    {
-        std::unique_lock<std::mutex> lock(queueMutex);
-        if (stop) {
-            throw std::runtime_error("ThreadPool is stopped");
-        }
-        tasks.emplace([task]() { (*task)(); });
-        activeTasks++;
-    }
-    
-    condition.notify_one();
+    push(Job([task]() { (*task)(); }), JobPriority::NORMAL);
     return result;
 }
+
+template<typename F>
+void ThreadPool::submit(F&& f, JobPriority priority) {
+    push(Job(std::forward<F>(f)), priority);
+}
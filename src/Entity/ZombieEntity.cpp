@@ -2,6 +2,7 @@
 
 #include "../Core/Logger.h"
 #include "../Model/Model.h"
+#include "../World/BlockAccessor.h"
 #include "../World/ChunkManager.h"
 
 #include <algorithm>
@@ -25,7 +26,7 @@ static std::string pickAnimByKeywords(const std::vector<std::string>& names, std
     return "";
 }
 
-static bool checkMobCollision(ChunkManager& chunkManager, const glm::vec3& feetPos) {
+static bool checkMobCollision(BlockAccessor& blocks, const glm::vec3& feetPos) {
     // AABB approx of a Minecraft mob. feetPos is at feet.
     constexpr float HALF_W = 0.30f;
     constexpr float HEIGHT = 1.80f;
@@ -37,15 +38,8 @@ static bool checkMobCollision(ChunkManager& chunkManager, const glm::vec3& feetP
     float minZ = feetPos.z - HALF_W;
     float maxZ = feetPos.z + HALF_W;
 
-    for (int x = (int)std::floor(minX); x <= (int)std::floor(maxX); ++x) {
-        for (int y = (int)std::floor(minY); y <= (int)std::floor(maxY); ++y) {
-            for (int z = (int)std::floor(minZ); z <= (int)std::floor(maxZ); ++z) {
-                Block b = chunkManager.getBlockAt(x, y, z);
-                if (b.isSolid()) return true;
-            }
-        }
-    }
-    return false;
+    return blocks.anySolid(glm::ivec3((int)std::floor(minX), (int)std::floor(minY), (int)std::floor(minZ)),
+                           glm::ivec3((int)std::floor(maxX), (int)std::floor(maxY), (int)std::floor(maxZ)));
 }
 
 static std::string pickWalkAnimPreferWalk(const std::vector<std::string>& names) {
@@ -131,15 +125,15 @@ glm::vec3 ZombieEntity::consumeAttackImpulse() {
     return out;
 }
 
-static bool tryStepUp(ChunkManager& chunkManager, glm::vec3& pos, float dx, float dz) {
+static bool tryStepUp(BlockAccessor& blocks, glm::vec3& pos, float dx, float dz) {
     // Minecraft-ish step-up: try moving up 1 block to clear a small ledge.
     constexpr float STEP = 1.0f;
     glm::vec3 tryPos = pos;
     tryPos.y += STEP;
-    if (checkMobCollision(chunkManager, tryPos)) return false;
+    if (checkMobCollision(blocks, tryPos)) return false;
     tryPos.x += dx;
     tryPos.z += dz;
-    if (checkMobCollision(chunkManager, tryPos)) return false;
+    if (checkMobCollision(blocks, tryPos)) return false;
     pos = tryPos;
     return true;
 }
@@ -155,29 +149,29 @@ struct GridKeyHash {
     }
 };
 
-static bool isWalkable(ChunkManager& cm, int x, int yFeet, int z) {
+static bool isWalkable(BlockAccessor& blocks, int x, int yFeet, int z) {
     // Need solid below + 2-block clearance.
-    Block below = cm.getBlockAt(x, yFeet - 1, z);
+    Block below = blocks.getBlock(x, yFeet - 1, z);
     if (!below.isSolid() && !below.isWater()) return false;
-    Block feet = cm.getBlockAt(x, yFeet, z);
-    Block head = cm.getBlockAt(x, yFeet + 1, z);
+    Block feet = blocks.getBlock(x, yFeet, z);
+    Block head = blocks.getBlock(x, yFeet + 1, z);
     return !feet.isSolid() && !head.isSolid();
 }
 
-static int findWalkableY(ChunkManager& cm, int x, int z, int yHint) {
+static int findWalkableY(BlockAccessor& blocks, int x, int z, int yHint) {
     // Search around yHint for a walkable spot (step up/down 1).
     for (int dy = 0; dy <= 1; ++dy) {
         int y = yHint + dy;
-        if (isWalkable(cm, x, y, z)) return y;
+        if (isWalkable(blocks, x, y, z)) return y;
     }
     for (int dy = 1; dy <= 2; ++dy) {
         int y = yHint - dy;
-        if (isWalkable(cm, x, y, z)) return y;
+        if (isWalkable(blocks, x, y, z)) return y;
     }
     return INT32_MIN;
 }
 
-static std::vector<glm::vec3> findPathAStar(ChunkManager& cm, const glm::vec3& startFeet, const glm::vec3& goalFeet, int maxRadius, int maxIters) {
+static std::vector<glm::vec3> findPathAStar(BlockAccessor& blocks, const glm::vec3& startFeet, const glm::vec3& goalFeet, int maxRadius, int maxIters) {
     // 2D A* in x/z; y is resolved per-node via findWalkableY().
     int sx = (int)std::floor(startFeet.x);
     int sz = (int)std::floor(startFeet.z);
@@ -187,9 +181,9 @@ static std::vector<glm::vec3> findPathAStar(ChunkManager& cm, const glm::vec3& s
     int gz = (int)std::floor(goalFeet.z);
     int gy = (int)std::floor(goalFeet.y);
 
-    int startY = findWalkableY(cm, sx, sz, sy);
+    int startY = findWalkableY(blocks, sx, sz, sy);
     if (startY == INT32_MIN) return {};
-    int goalY = findWalkableY(cm, gx, gz, gy);
+    int goalY = findWalkableY(blocks, gx, gz, gy);
     if (goalY == INT32_MIN) {
         // If player spot isn't walkable, still path toward closest x/z
         goalY = gy;
@@ -249,7 +243,7 @@ static std::vector<glm::vec3> findPathAStar(ChunkManager& cm, const glm::vec3& s
             int nz = cur.k.z + d[1];
             if (!inBounds(nx, nz)) continue;
 
-            int ny = findWalkableY(cm, nx, nz, cur.yFeet);
+            int ny = findWalkableY(blocks, nx, nz, cur.yFeet);
             if (ny == INT32_MIN) continue;
 
             float stepCost = 1.0f + 0.5f * (float)std::abs(ny - cur.yFeet); // prefer flat
@@ -290,6 +284,7 @@ bool ZombieEntity::updateAI(float deltaTime, ChunkManager& chunkManager, const g
 
     attackImpulse = glm::vec3(0.0f);
     bool attacked = false;
+    BlockAccessor blocks(chunkManager);
 
     attackCooldown = std::max(0.0f, attackCooldown - deltaTime);
     stateTimer -= deltaTime;
@@ -326,7 +321,7 @@ bool ZombieEntity::updateAI(float deltaTime, ChunkManager& chunkManager, const g
         pathReplanTimer -= deltaTime;
         if (pathReplanTimer <= 0.0f || pathPoints.empty() || pathIndex >= pathPoints.size()) {
             pathReplanTimer = 0.6f;
-            pathPoints = findPathAStar(chunkManager, position, playerPos, /*maxRadius*/24, /*maxIters*/2500);
+            pathPoints = findPathAStar(blocks, position, playerPos, /*maxRadius*/24, /*maxIters*/2500);
             pathIndex = 0;
         }
 
@@ -369,19 +364,19 @@ bool ZombieEntity::updateAI(float deltaTime, ChunkManager& chunkManager, const g
     // If we spawned inside blocks (or chunk just loaded), push up until not colliding.
     // This uses the same AABB collision as movement.
     for (int i = 0; i < 8; ++i) {
-        if (!checkMobCollision(chunkManager, position)) break;
+        if (!checkMobCollision(blocks, position)) break;
         position.y += 1.0f;
         velocity.y = 0.0f;
     }
 
     // Extra: if we're still colliding, try a small local nudge in XZ to escape corners.
-    if (checkMobCollision(chunkManager, position)) {
+    if (checkMobCollision(blocks, position)) {
         static const glm::vec3 nudges[] = {
             {0.5f, 0.0f, 0.0f}, {-0.5f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.5f}, {0.0f, 0.0f, -0.5f}
         };
         for (const auto& n : nudges) {
             glm::vec3 p = position + n;
-            if (!checkMobCollision(chunkManager, p)) { position = p; break; }
+            if (!checkMobCollision(blocks, p)) { position = p; break; }
         }
     }
 
@@ -403,8 +398,8 @@ bool ZombieEntity::updateAI(float deltaTime, ChunkManager& chunkManager, const g
     {
         int fx = (int)std::floor(position.x);
         int fz = (int)std::floor(position.z);
-        Block feet = chunkManager.getBlockAt(fx, (int)std::floor(position.y + 0.1f), fz);
-        Block head = chunkManager.getBlockAt(fx, (int)std::floor(position.y + 1.6f), fz);
+        Block feet = blocks.getBlock(fx, (int)std::floor(position.y + 0.1f), fz);
+        Block head = blocks.getBlock(fx, (int)std::floor(position.y + 1.6f), fz);
         inWater = feet.isWater() || head.isWater();
     }
 
@@ -426,9 +421,9 @@ bool ZombieEntity::updateAI(float deltaTime, ChunkManager& chunkManager, const g
     glm::vec3 step = velocity * deltaTime;
 
     // X
-    if (checkMobCollision(chunkManager, glm::vec3(pos.x + step.x, pos.y, pos.z))) {
+    if (checkMobCollision(blocks, glm::vec3(pos.x + step.x, pos.y, pos.z))) {
         // If grounded, try stepping up 1 block before giving up.
-        if (!(onGround && tryStepUp(chunkManager, pos, step.x, 0.0f))) {
+        if (!(onGround && tryStepUp(blocks, pos, step.x, 0.0f))) {
             step.x = 0.0f;
             velocity.x = 0.0f;
             if (state != State::Chase) chooseRandomWanderDir();
@@ -438,8 +433,8 @@ bool ZombieEntity::updateAI(float deltaTime, ChunkManager& chunkManager, const g
     }
 
     // Z
-    if (checkMobCollision(chunkManager, glm::vec3(pos.x, pos.y, pos.z + step.z))) {
-        if (!(onGround && tryStepUp(chunkManager, pos, 0.0f, step.z))) {
+    if (checkMobCollision(blocks, glm::vec3(pos.x, pos.y, pos.z + step.z))) {
+        if (!(onGround && tryStepUp(blocks, pos, 0.0f, step.z))) {
             step.z = 0.0f;
             velocity.z = 0.0f;
             if (state != State::Chase) chooseRandomWanderDir();
@@ -449,7 +444,7 @@ bool ZombieEntity::updateAI(float deltaTime, ChunkManager& chunkManager, const g
     }
 
     // Y
-    if (checkMobCollision(chunkManager, glm::vec3(pos.x, pos.y + step.y, pos.z))) {
+    if (checkMobCollision(blocks, glm::vec3(pos.x, pos.y + step.y, pos.z))) {
         if (step.y < 0.0f) onGround = true;
         step.y = 0.0f;
         velocity.y = 0.0f;
@@ -1,4 +1,5 @@
 #include "Mesh.h"
+#include <algorithm>
 
 Mesh::Mesh() : vao(0), vbo(0), ebo(0), vertexCount(0), indexCount(0), uploaded(false) {
     glGenVertexArrays(1, &vao);
@@ -26,6 +27,32 @@ void Mesh::upload(const std::vector<Vertex>& vertices, const std::vector<u32>& i
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
     glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(u32), indices.data(), GL_STATIC_DRAW);
     
+    setupAttributes();
+    glBindVertexArray(0);
+    
+    uploaded = true;
+}
+
+void Mesh::uploadQuads(const std::vector<Vertex>& vertices, const QuadIndexBuffer& quadIndices) {
+    vertexCount = vertices.size();
+    // MAX_CHUNK_QUADS bounds every chunk mesh; clamp rather than read past the shared buffer
+    indexCount = std::min(vertices.size() / 4, quadIndices.getQuadCapacity()) * 6;
+    
+    glBindVertexArray(vao);
+    
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), vertices.data(), GL_STATIC_DRAW);
+    
+    // The element buffer binding is VAO state: point it at the shared quad indices
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, quadIndices.getBuffer());
+    
+    setupAttributes();
+    glBindVertexArray(0);
+    
+    uploaded = true;
+}
+
+void Mesh::setupAttributes() {
     // Set up vertex attributes
     // Position (3 x int16)
     glEnableVertexAttribArray(0);
@@ -50,10 +77,6 @@ void Mesh::upload(const std::vector<Vertex>& vertices, const std::vector<u32>& i
     // Data (1 x uint8)
     glEnableVertexAttribArray(5);
     glVertexAttribIPointer(5, 1, GL_UNSIGNED_BYTE, sizeof(Vertex), (void*)offsetof(Vertex, data));
-    
-    glBindVertexArray(0);
-    
-    uploaded = true;
 }
 
 void Mesh::bind() const {
@@ -68,3 +91,55 @@ void Mesh::draw() const {
     if (!uploaded || indexCount == 0) return;
     glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(indexCount), GL_UNSIGNED_INT, 0);
 }
+
+size_t Mesh::drawFaceGroups(u32 groupMask) const {
+    if (!uploaded || indexCount == 0) return 0;
+
+    // Adjacent visible groups are merged into one range
+    GLsizei counts[7];
+    const void* offsets[7];
+    GLsizei ranges = 0;
+    size_t drawn = 0;
+    for (int group = 0; group < 7; ++group) {
+        // Groups are in vertices: 4 per quad, drawn with 6 indices
+        size_t first = static_cast<size_t>(faceGroups[group]) / 4 * 6;
+        size_t count = static_cast<size_t>(faceGroups[group + 1]) / 4 * 6 - first;
+        if (!(groupMask & (1u << group)) || count == 0) continue;
+        bool extends = ranges > 0 &&
+                       reinterpret_cast<size_t>(offsets[ranges - 1]) + counts[ranges - 1] * sizeof(u32) == first * sizeof(u32);
+        if (extends) {
+            counts[ranges - 1] += static_cast<GLsizei>(count);
+        } else {
+            counts[ranges] = static_cast<GLsizei>(count);
+            offsets[ranges] = reinterpret_cast<const void*>(first * sizeof(u32));
+            ++ranges;
+        }
+        drawn += count;
+    }
+    if (ranges > 0) glMultiDrawElements(GL_TRIANGLES, counts, GL_UNSIGNED_INT, offsets, ranges);
+    return drawn;
+}
+
+QuadIndexBuffer::QuadIndexBuffer(size_t quads) : ebo(0), quads(quads) {
+    std::vector<u32> indices(quads * 6);
+    for (size_t q = 0; q < quads; ++q) {
+        u32 base = static_cast<u32>(q * 4);
+        u32* quad = &indices[q * 6];
+        quad[0] = base + 0; quad[1] = base + 1; quad[2] = base + 2;
+        quad[3] = base + 0; quad[4] = base + 2; quad[5] = base + 3;
+    }
+
+    glGenBuffers(1, &ebo);
+    // Bound through a throwaway VAO so no other VAO's element binding changes
+    GLuint vao = 0;
+    glGenVertexArrays(1, &vao);
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(u32), indices.data(), GL_STATIC_DRAW);
+    glBindVertexArray(0);
+    glDeleteVertexArrays(1, &vao);
+}
+
+QuadIndexBuffer::~QuadIndexBuffer() {
+    if (ebo) glDeleteBuffers(1, &ebo);
+}
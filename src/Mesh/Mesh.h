@@ -3,27 +3,62 @@
 #include "../Util/Types.h"
 #include "Vertex.h"
 #include <glad/glad.h>
+#include <array>
 #include <vector>
 
+// Index buffer shared by every chunk mesh (see MeshData): quad q is drawn as
+// 4q + {0, 1, 2, 0, 2, 3}, so chunks upload vertices only
+class QuadIndexBuffer {
+public:
+    explicit QuadIndexBuffer(size_t quads);
+    ~QuadIndexBuffer();
+
+    QuadIndexBuffer(const QuadIndexBuffer&) = delete;
+    QuadIndexBuffer& operator=(const QuadIndexBuffer&) = delete;
+
+    GLuint getBuffer() const { return ebo; }
+    size_t getQuadCapacity() const { return quads; }
+    size_t getMemoryUsage() const { return quads * 6 * sizeof(u32); }
+
+private:
+    GLuint ebo;
+    size_t quads;
+};
+
 class Mesh {
 public:
     Mesh();
     ~Mesh();
 
     void upload(const std::vector<Vertex>& vertices, const std::vector<u32>& indices);
+    // Quad list drawn with the shared indices (at most quadIndices.getQuadCapacity() quads)
+    void uploadQuads(const std::vector<Vertex>& vertices, const QuadIndexBuffer& quadIndices);
     void bind() const;
     void unbind() const;
     void draw() const;
+
+    // Chunk meshes: vertex ranges per face direction (see MeshData::faceGroups) and local bounds
+    void setFaceGroups(const std::array<u32, 8>& groups) { faceGroups = groups; }
+    void setBounds(const glm::vec3& min, const glm::vec3& max) { boundsMin = min; boundsMax = max; }
+    const glm::vec3& getBoundsMin() const { return boundsMin; }
+    const glm::vec3& getBoundsMax() const { return boundsMax; }
+    // Draws the groups whose bit is set (bit i = group i) in one call; returns the indices drawn
+    size_t drawFaceGroups(u32 groupMask) const;
     
     bool isUploaded() const { return uploaded; }
     size_t getVertexCount() const { return vertexCount; }
     size_t getIndexCount() const { return indexCount; }
 
 private:
+    void setupAttributes(); // VAO must be bound
+
     GLuint vao;
     GLuint vbo;
     GLuint ebo;
     size_t vertexCount;
     size_t indexCount;
     bool uploaded;
+    std::array<u32, 8> faceGroups = {};
+    glm::vec3 boundsMin = glm::vec3(0.0f);
+    glm::vec3 boundsMax = glm::vec3(0.0f);
 };
@@ -1,33 +1,100 @@
 #include "MeshBuilder.h"
 #include "../Util/Config.h"
+#include "../World/ChunkMap.h"
 #include <array>
+#include <bit>
 #include <cstring>
 #include <tuple>
 #include <unordered_map>
 
-MeshData MeshBuilder::buildChunkMesh(std::shared_ptr<Chunk> chunk,
-                                     std::shared_ptr<Chunk> chunkXPos,
-                                     std::shared_ptr<Chunk> chunkXNeg,
-                                     std::shared_ptr<Chunk> chunkYPos,
-                                     std::shared_ptr<Chunk> chunkYNeg,
-                                     std::shared_ptr<Chunk> chunkZPos,
-                                     std::shared_ptr<Chunk> chunkZNeg,
-                                     int lod) {
+namespace {
+// Face directions in meshing order and their (u, v, w) sweep axes
+const int FACE_DIRS[6][3] = {
+    {1, 0, 0}, {-1, 0, 0},  // X+, X-
+    {0, 1, 0}, {0, -1, 0},  // Y+, Y-
+    {0, 0, 1}, {0, 0, -1}   // Z+, Z-
+};
+const int FACE_AXES[6][3] = {
+    {1, 2, 0}, {1, 2, 0},
+    {0, 2, 1}, {0, 2, 1},
+    {0, 1, 2}, {0, 1, 2}
+};
+
+// Bit planes of the binary mesher; every block that can own a face is in exactly one
+enum FacePlane { PLANE_OPAQUE, PLANE_WATER, PLANE_ICE, PLANE_LEAVES, PLANE_COUNT };
+
+int facePlaneOf(Block block) {
+    if (block.isOpaque()) return PLANE_OPAQUE;
+    switch (block.getType()) {
+        case BlockType::WATER: return PLANE_WATER;
+        case BlockType::ICE: return PLANE_ICE;
+        case BlockType::LEAVES: return PLANE_LEAVES;
+        default: return -1; // Air and cross models
+    }
+}
+}
+
+MeshBuilder::MeshBuilder() {
+    meshCache.reserve(MESH_CACHE_SIZE);
+    spareMeshes.reserve(MESH_CACHE_SIZE);
+}
+
+MeshData MeshBuilder::buildChunkMesh(const ChunkNeighborhood& neighborhood, int lod) {
+    // One guard for the whole build, so the block reads below don't each take one
+    ChunkMap::ReadGuard guard;
     MeshData meshData;
+    const std::shared_ptr<Chunk>& chunk = neighborhood[NEIGHBORHOOD_CENTER];
     
-    std::shared_ptr<Chunk> neighbors[6] = {
-        chunkXPos, chunkXNeg, chunkYPos, chunkYNeg, chunkZPos, chunkZNeg
-    };
+    // Fast path: uniform chunks either emit nothing at all (air) or only their
+    // border faces, which are all hidden when every neighbor is opaque there
+    Block uniform;
+    if (chunk->getUniformBlock(uniform)) {
+        if (uniform.getType() == BlockType::AIR) {
+            uniformAirSkipped.fetch_add(1, std::memory_order_relaxed);
+            return meshData;
+        }
+        if (uniform.isOpaque() && isEnclosed(neighborhood)) {
+            enclosedSolidSkipped.fetch_add(1, std::memory_order_relaxed);
+            return meshData;
+        }
+    }
+
+    meshData = acquireBuffers(chunk->getMeshSizeHint());
+    size_t reserved = meshData.capacity();
+
+    PaddedVolume volume;
+    volume.fill(neighborhood, lod);
+
+    // LOD 0 re-meshes only the slices that changed since the chunk's cached mesh
+    SegmentBuild build;
+    std::unique_ptr<CachedMesh> cached;
+    bool edited = false;
+    if (lod == 0) {
+        edited = chunk->takeEdited();
+        cached = takeCachedMesh(chunk->getPosition());
+        if (cached) {
+            build.previous = cached.get();
+            findDirtySlices(volume, build);
+            incrementalBuilds.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    SegmentBuild* segments = lod == 0 ? &build : nullptr;
     
-    // Pass 1: Standard Greedy Meshing for solid blocks
-    greedyMesh(chunk, neighbors, meshData, lod);
+    // Pass 1: Greedy meshing for solid blocks and water
+    if (lod == 0 && getAlgorithm() == MeshingAlgorithm::BINARY) {
+        binaryGreedyMesh(volume, meshData, segments);
+    } else {
+        greedyMesh(volume, meshData, lod, segments);
+    }
     
+    meshData.faceGroups[6] = static_cast<u32>(meshData.vertices.size());
+
     // Pass 2: Special models (Vegetation) - Only at LOD 0 for now to save perf
-    if (lod == 0) {
+    if (lod == 0 && beginSegment(meshData, segments, CROSS_SEGMENT, build.crossesDirty)) {
         for (int y = 0; y < CHUNK_HEIGHT; ++y) {
             for (int z = 0; z < CHUNK_SIZE; ++z) {
                 for (int x = 0; x < CHUNK_SIZE; ++x) {
-                    Block block = chunk->getBlock(x, y, z);
+                    Block block = volume.get(x, y, z);
                     if (block.isCrossModel()) {
                         // Simple AO for plant: check block below
                         u8 ao = 3; // Default bright
@@ -39,10 +106,350 @@ MeshData MeshBuilder::buildChunkMesh(std::shared_ptr<Chunk> chunk,
             }
         }
     }
-    
+
+    meshData.faceGroups[7] = static_cast<u32>(meshData.vertices.size());
+    computeBounds(meshData);
+
+    if (lod == 0) {
+        build.segments[SEGMENT_COUNT] = {static_cast<u32>(meshData.vertices.size()), static_cast<u32>(meshData.waterVertices.size())};
+        // Only chunks being edited are likely to be re-meshed again soon
+        if (edited) storeCachedMesh(chunk->getPosition(), std::move(cached), volume, meshData, build.segments);
+        else releaseCachedMesh(std::move(cached));
+    }
+
+    if (meshData.capacity() != reserved) bufferGrowths.fetch_add(1, std::memory_order_relaxed);
+    chunk->setMeshSizeHint({static_cast<u32>(meshData.vertices.size()), static_cast<u32>(meshData.waterVertices.size())});
+    return meshData;
+}
+
+MeshData MeshBuilder::acquireBuffers(const Chunk::MeshSizeHint& hint) {
+    MeshData meshData;
+    {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        if (!bufferPool.empty()) {
+            meshData = std::move(bufferPool.back());
+            bufferPool.pop_back();
+        }
+    }
+    if (meshData.capacity() > 0) pooledBuffers.fetch_add(1, std::memory_order_relaxed);
+    else freshBuffers.fetch_add(1, std::memory_order_relaxed);
+
+    // Buffers only ever grow; reserve is a no-op once a pooled buffer is big enough
+    meshData.clear();
+    meshData.vertices.reserve(hint.vertices);
+    meshData.waterVertices.reserve(hint.waterVertices);
     return meshData;
 }
 
+void MeshBuilder::computeBounds(MeshData& meshData) {
+    glm::vec3 lo(static_cast<float>(CHUNK_SIZE));
+    glm::vec3 hi(0.0f);
+    for (const auto* vertices : {&meshData.vertices, &meshData.waterVertices}) {
+        for (const Vertex& vertex : *vertices) {
+            glm::vec3 p(vertex.x, vertex.y, vertex.z);
+            lo = glm::min(lo, p);
+            hi = glm::max(hi, p);
+        }
+    }
+    if (meshData.isEmpty()) lo = hi = glm::vec3(0.0f);
+    meshData.boundsMin = lo;
+    meshData.boundsMax = hi;
+}
+
+bool MeshBuilder::beginSegment(MeshData& meshData, SegmentBuild* build, int segment, bool dirty) {
+    if (!build) return true;
+    build->segments[segment] = {static_cast<u32>(meshData.vertices.size()), static_cast<u32>(meshData.waterVertices.size())};
+    if (!build->previous || dirty) {
+        if (build->previous) slicesRebuilt.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Append the previous mesh's segment; quads carry no indices, so it's a plain copy
+    const MeshData& old = build->previous->meshData;
+    const SegmentStart& begin = build->previous->segments[segment];
+    const SegmentStart& end = build->previous->segments[segment + 1];
+    meshData.vertices.insert(meshData.vertices.end(), old.vertices.begin() + begin.vertices, old.vertices.begin() + end.vertices);
+    meshData.waterVertices.insert(meshData.waterVertices.end(), old.waterVertices.begin() + begin.waterVertices,
+                                  old.waterVertices.begin() + end.waterVertices);
+    slicesReused.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void MeshBuilder::findDirtySlices(const PaddedVolume& volume, SegmentBuild& build) const {
+    static_assert(CHUNK_SIZE == CHUNK_HEIGHT && CHUNK_SIZE + 2 <= 32, "one u32 of slices per axis");
+    // A changed block at coordinate c dirties slices c - 1 .. c + 1 along every axis
+    u32 axisDirty[3] = {};
+    bool interiorChanged = false;
+    const PaddedVolume& previous = build.previous->volume;
+    for (int y = -1; y <= CHUNK_HEIGHT; ++y) {
+        for (int z = -1; z <= CHUNK_SIZE; ++z) {
+            for (int x = -1; x <= CHUNK_SIZE; ++x) {
+                if (volume.get(x, y, z) == previous.get(x, y, z)) continue;
+                // Bit c + 1 per axis, spread to its neighbors below
+                axisDirty[0] |= 1u << (x + 1);
+                axisDirty[1] |= 1u << (y + 1);
+                axisDirty[2] |= 1u << (z + 1);
+                interiorChanged |= x >= 0 && x < CHUNK_SIZE && y >= 0 && y < CHUNK_HEIGHT && z >= 0 && z < CHUNK_SIZE;
+            }
+        }
+    }
+
+    for (int dir = 0; dir < 6; ++dir) {
+        u32 changed = axisDirty[FACE_AXES[dir][2]];
+        // Bit p is coordinate p - 1, which dirties slices p - 2 .. p
+        build.dirty[dir] = (changed | (changed >> 1) | (changed >> 2)) & ((1u << CHUNK_SIZE) - 1);
+    }
+    build.crossesDirty = interiorChanged;
+}
+
+std::unique_ptr<MeshBuilder::CachedMesh> MeshBuilder::takeCachedMesh(const ChunkPos& pos) {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    for (auto& entry : meshCache) {
+        if (entry->pos != pos) continue;
+        std::unique_ptr<CachedMesh> cached = std::move(entry);
+        entry = std::move(meshCache.back());
+        meshCache.pop_back();
+        return cached;
+    }
+    return nullptr;
+}
+
+void MeshBuilder::storeCachedMesh(const ChunkPos& pos, std::unique_ptr<CachedMesh> cached, const PaddedVolume& volume,
+                                  const MeshData& meshData, const Segments& segments) {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    if (!cached && !spareMeshes.empty()) {
+        cached = std::move(spareMeshes.back());
+        spareMeshes.pop_back();
+    }
+    // Room for the entry: drop a spare, or reuse the least recently built entry
+    while (meshCache.size() + spareMeshes.size() >= MESH_CACHE_SIZE) {
+        if (!spareMeshes.empty()) {
+            spareMeshes.pop_back();
+            continue;
+        }
+        auto oldest = meshCache.begin();
+        for (auto it = meshCache.begin(); it != meshCache.end(); ++it) {
+            if ((*it)->lastUse < (*oldest)->lastUse) oldest = it;
+        }
+        std::unique_ptr<CachedMesh> evicted = std::move(*oldest);
+        *oldest = std::move(meshCache.back());
+        meshCache.pop_back();
+        if (!cached) cached = std::move(evicted);
+    }
+    if (!cached) cached = std::make_unique<CachedMesh>();
+
+    // Copies into the entry's own buffers, which only grow
+    cached->pos = pos;
+    cached->volume = volume;
+    cached->meshData.vertices.assign(meshData.vertices.begin(), meshData.vertices.end());
+    cached->meshData.waterVertices.assign(meshData.waterVertices.begin(), meshData.waterVertices.end());
+    cached->segments = segments;
+    cached->lastUse = ++cacheClock;
+    // Another build of the same chunk may have stored meanwhile; either mesh is a valid base
+    for (auto& entry : meshCache) {
+        if (entry->pos != pos) continue;
+        std::swap(entry, cached);
+        spareMeshes.push_back(std::move(cached));
+        return;
+    }
+    meshCache.push_back(std::move(cached));
+}
+
+void MeshBuilder::releaseCachedMesh(std::unique_ptr<CachedMesh> cached) {
+    if (!cached) return;
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    // Entries taken by builds in flight may overshoot the bound; those are freed
+    if (meshCache.size() + spareMeshes.size() < MESH_CACHE_SIZE) spareMeshes.push_back(std::move(cached));
+}
+
+void MeshBuilder::recycle(MeshData&& meshData) {
+    if (meshData.capacity() == 0) return; // Skipped chunks never took buffers
+    std::lock_guard<std::mutex> lock(poolMutex);
+    if (bufferPool.size() < MESH_BUFFER_POOL_SIZE) {
+        bufferPool.push_back(std::move(meshData));
+    }
+}
+
+void MeshBuilder::PaddedVolume::fill(const ChunkNeighborhood& neighborhood, int lod) {
+    std::array<Block, CHUNK_VOLUME> source;
+    std::array<Chunk::MipCell, Chunk::mipSize(1) * Chunk::mipSize(1) * Chunk::mipSize(1)> cells;
+    const int sizes[3] = {CHUNK_SIZE, CHUNK_HEIGHT, CHUNK_SIZE};
+
+    for (int dy = -1; dy <= 1; ++dy) {
+        for (int dz = -1; dz <= 1; ++dz) {
+            for (int dx = -1; dx <= 1; ++dx) {
+                // Range of padded coordinates this neighbor covers along each axis
+                const int d[3] = {dx, dy, dz};
+                int lo[3], hi[3];
+                for (int a = 0; a < 3; ++a) {
+                    lo[a] = d[a] < 0 ? -1 : d[a] == 0 ? 0 : sizes[a];
+                    hi[a] = d[a] < 0 ? -1 : d[a] == 0 ? sizes[a] - 1 : sizes[a];
+                }
+
+                const std::shared_ptr<Chunk>& chunk = neighborhood[(dy + 1) * 9 + (dz + 1) * 3 + (dx + 1)];
+                bool center = dx == 0 && dy == 0 && dz == 0;
+                Block uniform(BlockType::AIR);
+                bool flat = !chunk || chunk->getUniformBlock(uniform);
+
+                // LOD meshes read downsampled cells. Across a LOD boundary both sides read the
+                // coarser level and only count fully opaque cells as opaque, so each side keeps
+                // its border faces wherever the other side's mesh might not cover them.
+                int neighborLod = center || !chunk ? lod : chunk->getCurrentLOD();
+                int level = std::min(std::max(lod, neighborLod), CHUNK_MIP_LEVELS);
+                bool seam = neighborLod != lod;
+                if (flat) {
+                    level = 0;
+                } else if (level > 0) {
+                    chunk->copyMipLevel(level, cells.data());
+                } else if (center) {
+                    // One consistent copy of the center; neighbors only contribute a thin slab
+                    chunk->copyBlocks(source.data());
+                }
+                int cellSize = Chunk::mipSize(level);
+
+                for (int y = lo[1]; y <= hi[1]; ++y) {
+                    for (int z = lo[2]; z <= hi[2]; ++z) {
+                        Block* row = &blocks[((y + 1) * SIZE_Z + (z + 1)) * SIZE_X + 1];
+                        int ly = y - dy * CHUNK_HEIGHT;
+                        int lz = z - dz * CHUNK_SIZE;
+                        for (int x = lo[0]; x <= hi[0]; ++x) {
+                            int lx = x - dx * CHUNK_SIZE;
+                            if (flat) {
+                                row[x] = uniform;
+                            } else if (level > 0) {
+                                const Chunk::MipCell& cell =
+                                    cells[((ly >> level) * cellSize + (lz >> level)) * cellSize + (lx >> level)];
+                                bool partial = cell.opaque < Chunk::mipCellVolume(level);
+                                row[x] = seam && partial && cell.block.isOpaque() ? Block(BlockType::AIR) : cell.block;
+                            } else if (center) {
+                                row[x] = source[y * CHUNK_AREA + z * CHUNK_SIZE + x];
+                            } else {
+                                row[x] = chunk->getBlock(lx, ly, lz);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+void MeshBuilder::emitQuad(const PaddedVolume& volume, MeshData& meshData, int dir,
+                           int d, int u, int v, int w, int h, u8 material, u8 data, int step) {
+    int nx = FACE_DIRS[dir][0];
+    int ny = FACE_DIRS[dir][1];
+    int nz = FACE_DIRS[dir][2];
+    int u_axis = FACE_AXES[dir][0];
+    int v_axis = FACE_AXES[dir][1];
+    int w_axis = FACE_AXES[dir][2];
+
+    Quad quad;
+    if (w_axis == 0) {
+        quad.x = ((nx > 0) ? d + 1 : d) * step; 
+        quad.y = u * step; 
+        quad.z = v * step;
+    } else if (w_axis == 1) {
+        quad.x = u * step; 
+        quad.y = ((ny > 0) ? d + 1 : d) * step; 
+        quad.z = v * step;
+    } else {
+        quad.x = u * step; 
+        quad.y = v * step; 
+        quad.z = ((nz > 0) ? d + 1 : d) * step;
+    }
+    
+    quad.w = w * step; 
+    quad.h = h * step;
+    
+    quad.u_axis = u_axis;
+    quad.v_axis = v_axis;
+    
+    quad.nx = nx;
+    quad.ny = ny;
+    quad.nz = nz;
+    
+    quad.normal = Vertex::packNormal(nx, ny, nz);
+    quad.material = material;
+    quad.data = data;
+    
+    // Calculate AO
+    // For LOD > 0, we can simplify AO or just sample at corners
+    // We'll use the same logic but with 'step' for neighbor checks
+    
+    int u_vec[3] = {0}; u_vec[u_axis] = step;
+    int v_vec[3] = {0}; v_vec[v_axis] = step;
+    int n_vec[3] = {nx * step, ny * step, nz * step};
+    int neg_u[3] = {-u_vec[0], -u_vec[1], -u_vec[2]};
+    int neg_v[3] = {-v_vec[0], -v_vec[1], -v_vec[2]};
+    
+    // V0: (0, 0) -> Block (0, 0), check -u, -v
+    quad.ao[0] = calculateVertexAO(volume, quad.x, quad.y, quad.z, neg_u, neg_v);
+    
+    // V1: (w, 0) -> Block (w-1, 0), check +u, -v
+    int bx = quad.x + (quad.w - step)*u_vec[0]/step;
+    int by = quad.y + (quad.w - step)*u_vec[1]/step;
+    int bz = quad.z + (quad.w - step)*u_vec[2]/step;
+    quad.ao[1] = calculateVertexAO(volume, bx, by, bz, u_vec, neg_v);
+    
+    // V2: (w, h) -> Block (w-1, h-1), check +u, +v
+    bx = quad.x + (quad.w - step)*u_vec[0]/step + (quad.h - step)*v_vec[0]/step;
+    by = quad.y + (quad.w - step)*u_vec[1]/step + (quad.h - step)*v_vec[1]/step;
+    bz = quad.z + (quad.w - step)*u_vec[2]/step + (quad.h - step)*v_vec[2]/step;
+    quad.ao[2] = calculateVertexAO(volume, bx, by, bz, u_vec, v_vec);
+    
+    // V3: (0, h) -> Block (0, h-1), check -u, +v
+    bx = quad.x + (quad.h - step)*v_vec[0]/step;
+    by = quad.y + (quad.h - step)*v_vec[1]/step;
+    bz = quad.z + (quad.h - step)*v_vec[2]/step;
+    quad.ao[3] = calculateVertexAO(volume, bx, by, bz, neg_u, v_vec);
+
+    // Water corners take the level of their vertical edge (layer of the corner's own block),
+    // which slopes flowing water between levels and keeps shared corners crack-free
+    for (int i = 0; i < 4; ++i) quad.levels[i] = data & 0x0F;
+    if (material == static_cast<u8>(BlockType::WATER)) {
+        const int cornerU[4] = {0, quad.w, quad.w, 0};
+        const int cornerV[4] = {0, 0, quad.h, quad.h};
+        for (int i = 0; i < 4; ++i) {
+            int p[3] = {quad.x, quad.y, quad.z};
+            p[u_axis] += cornerU[i];
+            p[v_axis] += cornerV[i];
+            // Block of the quad at this corner (one step in from the far edges, behind the face)
+            int layer = quad.y;
+            if (u_axis == 1 && cornerU[i] > 0) layer += cornerU[i] - step;
+            if (v_axis == 1 && cornerV[i] > 0) layer += cornerV[i] - step;
+            if (ny > 0) layer -= step;
+            quad.levels[i] = waterCornerLevel(volume, p[0], layer, p[2], step);
+        }
+    }
+
+    addQuad(quad, meshData);
+}
+
+u8 MeshBuilder::waterCornerLevel(const PaddedVolume& volume, int x, int y, int z, int step) {
+    u8 level = 0x0F;
+    for (int dz = -step; dz <= 0; dz += step) {
+        for (int dx = -step; dx <= 0; dx += step) {
+            Block block = volume.get(x + dx, y, z + dz);
+            if (block.isWater()) level = std::min<u8>(level, block.getData() & 0x0F);
+        }
+    }
+    return level;
+}
+
+bool MeshBuilder::isEnclosed(const ChunkNeighborhood& neighborhood) const {
+    // Layer of each face neighbor that borders the chunk (what the padded volume holds)
+    const int indices[6] = {14, 12, 16, 10, 22, 4}; // X+, X-, Z+, Z-, Y+, Y-
+    const int axes[6] = {0, 0, 2, 2, 1, 1};
+    const int layers[6] = {0, CHUNK_SIZE - 1, 0, CHUNK_SIZE - 1, 0, CHUNK_HEIGHT - 1};
+
+    for (int i = 0; i < 6; ++i) {
+        // A missing neighbor is treated as air, so the border would be visible
+        const std::shared_ptr<Chunk>& neighbor = neighborhood[indices[i]];
+        if (!neighbor || !neighbor->isLayerOpaque(axes[i], layers[i])) return false;
+    }
+    return true;
+}
+
 void MeshBuilder::addCross(int x, int y, int z, u8 material, u8 ao, MeshData& meshData) {
     // Two intersecting quads
     // Quad 1: (0,0,0) to (1,1,1)
@@ -54,84 +461,60 @@ void MeshBuilder::addCross(int x, int y, int z, u8 material, u8 ao, MeshData& me
     u16 uv01 = Vertex::packUV(0, 1);
     
     u8 normalUp = Vertex::packNormal(0, 1, 0); // Fake normal up for lighting
+
+    auto addDoubleSided = [&](const Vertex (&corners)[4]) {
+        // Front, then the back as the same corners in reverse winding
+        static const int ORDER[8] = {0, 1, 2, 3, 0, 3, 2, 1};
+        for (int i : ORDER) meshData.vertices.push_back(corners[i]);
+    };
     
     // Quad 1
-    meshData.vertices.emplace_back(static_cast<i16>(x), static_cast<i16>(y), static_cast<i16>(z), normalUp, material, uv00, ao, (u8)0);
-    meshData.vertices.emplace_back(static_cast<i16>(x + 1), static_cast<i16>(y), static_cast<i16>(z + 1), normalUp, material, uv10, ao, (u8)0);
-    meshData.vertices.emplace_back(static_cast<i16>(x + 1), static_cast<i16>(y + 1), static_cast<i16>(z + 1), normalUp, material, uv11, ao, (u8)0);
-    meshData.vertices.emplace_back(static_cast<i16>(x), static_cast<i16>(y + 1), static_cast<i16>(z), normalUp, material, uv01, ao, (u8)0);
-    
-    u32 baseIdx = static_cast<u32>(meshData.vertices.size()) - 4;
-    // Double sided
-    meshData.indices.push_back(baseIdx + 0); meshData.indices.push_back(baseIdx + 1); meshData.indices.push_back(baseIdx + 2);
-    meshData.indices.push_back(baseIdx + 0); meshData.indices.push_back(baseIdx + 2); meshData.indices.push_back(baseIdx + 3);
-    meshData.indices.push_back(baseIdx + 2); meshData.indices.push_back(baseIdx + 1); meshData.indices.push_back(baseIdx + 0);
-    meshData.indices.push_back(baseIdx + 3); meshData.indices.push_back(baseIdx + 2); meshData.indices.push_back(baseIdx + 0);
+    addDoubleSided({
+        Vertex(static_cast<i16>(x), static_cast<i16>(y), static_cast<i16>(z), normalUp, material, uv00, ao, (u8)0),
+        Vertex(static_cast<i16>(x + 1), static_cast<i16>(y), static_cast<i16>(z + 1), normalUp, material, uv10, ao, (u8)0),
+        Vertex(static_cast<i16>(x + 1), static_cast<i16>(y + 1), static_cast<i16>(z + 1), normalUp, material, uv11, ao, (u8)0),
+        Vertex(static_cast<i16>(x), static_cast<i16>(y + 1), static_cast<i16>(z), normalUp, material, uv01, ao, (u8)0)
+    });
 
     // Quad 2
-    meshData.vertices.emplace_back(static_cast<i16>(x), static_cast<i16>(y), static_cast<i16>(z + 1), normalUp, material, uv00, ao, (u8)0);
-    meshData.vertices.emplace_back(static_cast<i16>(x + 1), static_cast<i16>(y), static_cast<i16>(z), normalUp, material, uv10, ao, (u8)0);
-    meshData.vertices.emplace_back(static_cast<i16>(x + 1), static_cast<i16>(y + 1), static_cast<i16>(z), normalUp, material, uv11, ao, (u8)0);
-    meshData.vertices.emplace_back(static_cast<i16>(x), static_cast<i16>(y + 1), static_cast<i16>(z + 1), normalUp, material, uv01, ao, (u8)0);
-    
-    baseIdx = static_cast<u32>(meshData.vertices.size()) - 4;
-    // Double sided
-    meshData.indices.push_back(baseIdx + 0); meshData.indices.push_back(baseIdx + 1); meshData.indices.push_back(baseIdx + 2);
-    meshData.indices.push_back(baseIdx + 0); meshData.indices.push_back(baseIdx + 2); meshData.indices.push_back(baseIdx + 3);
-    meshData.indices.push_back(baseIdx + 2); meshData.indices.push_back(baseIdx + 1); meshData.indices.push_back(baseIdx + 0);
-    meshData.indices.push_back(baseIdx + 3); meshData.indices.push_back(baseIdx + 2); meshData.indices.push_back(baseIdx + 0);
+    addDoubleSided({
+        Vertex(static_cast<i16>(x), static_cast<i16>(y), static_cast<i16>(z + 1), normalUp, material, uv00, ao, (u8)0),
+        Vertex(static_cast<i16>(x + 1), static_cast<i16>(y), static_cast<i16>(z), normalUp, material, uv10, ao, (u8)0),
+        Vertex(static_cast<i16>(x + 1), static_cast<i16>(y + 1), static_cast<i16>(z), normalUp, material, uv11, ao, (u8)0),
+        Vertex(static_cast<i16>(x), static_cast<i16>(y + 1), static_cast<i16>(z + 1), normalUp, material, uv01, ao, (u8)0)
+    });
 }
 
-void MeshBuilder::greedyMesh(std::shared_ptr<Chunk> chunk,
-                             std::shared_ptr<Chunk> neighbors[6],
+void MeshBuilder::greedyMesh(const PaddedVolume& volume,
                              MeshData& meshData,
-                             int lod) {
+                             int lod,
+                             SegmentBuild* build) {
     // Greedy meshing for each axis and direction
-    const int dirs[6][3] = {
-        {1, 0, 0}, {-1, 0, 0},  // X+, X-
-        {0, 1, 0}, {0, -1, 0},  // Y+, Y-
-        {0, 0, 1}, {0, 0, -1}   // Z+, Z-
-    };
-    
     int step = 1 << lod;
     int size = CHUNK_SIZE >> lod;
     // int height = CHUNK_HEIGHT >> lod; // Unused
     
-    auto getBlockGlobal = [&](int gx, int gy, int gz) -> Block {
-        if (gx < 0 || gx >= CHUNK_SIZE || gy < 0 || gy >= CHUNK_HEIGHT || gz < 0 || gz >= CHUNK_SIZE) {
-            if (gx < 0 && neighbors[1]) return neighbors[1]->getBlock(gx + CHUNK_SIZE, gy, gz);
-            if (gx >= CHUNK_SIZE && neighbors[0]) return neighbors[0]->getBlock(gx - CHUNK_SIZE, gy, gz);
-            if (gy < 0 && neighbors[3]) return neighbors[3]->getBlock(gx, gy + CHUNK_HEIGHT, gz);
-            if (gy >= CHUNK_HEIGHT && neighbors[2]) return neighbors[2]->getBlock(gx, gy - CHUNK_HEIGHT, gz);
-            if (gz < 0 && neighbors[5]) return neighbors[5]->getBlock(gx, gy, gz + CHUNK_SIZE);
-            if (gz >= CHUNK_SIZE && neighbors[4]) return neighbors[4]->getBlock(gx, gy, gz - CHUNK_SIZE);
-            return Block(BlockType::AIR);
-        }
-        return chunk->getBlock(gx, gy, gz);
-    };
-
-    // Simple sampling for performance (O(1))
-    // We rely on increased LOD distance to hide the block alignment artifacts.
+    // O(1) sampling: at LOD > 0 the volume already holds the downsampled mip cells
     auto sampleBlock = [&](int baseX, int baseY, int baseZ) -> Block {
-        return getBlockGlobal(baseX, baseY, baseZ);
+        return volume.get(baseX, baseY, baseZ);
     };
 
     for (int dir = 0; dir < 6; ++dir) {
-        int nx = dirs[dir][0];
-        int ny = dirs[dir][1];
-        int nz = dirs[dir][2];
+        meshData.faceGroups[dir] = static_cast<u32>(meshData.vertices.size());
+        int nx = FACE_DIRS[dir][0];
+        int ny = FACE_DIRS[dir][1];
+        int nz = FACE_DIRS[dir][2];
         
-        // Determine sweep axes
-        int u_axis, v_axis, w_axis;
-        if (nx != 0) { u_axis = 1; v_axis = 2; w_axis = 0; }
-        else if (ny != 0) { u_axis = 0; v_axis = 2; w_axis = 1; }
-        else { u_axis = 0; v_axis = 1; w_axis = 2; }
+        // Sweep axes
+        int u_axis = FACE_AXES[dir][0];
+        int w_axis = FACE_AXES[dir][2];
         
-        // Create mask for this direction
-        std::vector<u16> mask(size * size);
+        // Mask for this direction (sized for LOD 0, only size * size is used)
+        std::array<u16, CHUNK_SIZE * CHUNK_SIZE> mask;
         
         for (int d = 0; d < size; ++d) {
-            std::fill(mask.begin(), mask.end(), static_cast<u16>(0));
+            if (!beginSegment(meshData, build, dir * CHUNK_SIZE + d, build && (build->dirty[dir] >> d & 1u))) continue;
+            std::fill(mask.begin(), mask.begin() + size * size, static_cast<u16>(0));
             
             // Build mask
             for (int v = 0; v < size; ++v) {
@@ -207,10 +590,13 @@ void MeshBuilder::greedyMesh(std::shared_ptr<Chunk> chunk,
                     u8 material = static_cast<u8>(val & 0xFF);
                     u8 data = static_cast<u8>((val >> 8) & 0xFF);
                     
+                    // Flowing water stays 1x1: its corners are displaced per block (waves, levels),
+                    // a merged quad would open gaps. Still water and ice are flat and merge.
+                    bool merge = material != static_cast<u8>(BlockType::WATER) || (data & 0x0F) == 0;
+
                     // Compute width
                     int w = 1;
-                    // Disable greedy meshing for water and ice to prevent gaps with vertex displacement
-                    if (material != static_cast<u8>(BlockType::WATER) && material != static_cast<u8>(BlockType::ICE)) {
+                    if (merge) {
                         while (u + w < size && mask[v * size + u + w] == val) {
                             ++w;
                         }
@@ -219,7 +605,7 @@ void MeshBuilder::greedyMesh(std::shared_ptr<Chunk> chunk,
                     // Compute height
                     int h = 1;
                     bool done = false;
-                    if (material != static_cast<u8>(BlockType::WATER) && material != static_cast<u8>(BlockType::ICE)) {
+                    if (merge) {
                         while (v + h < size && !done) {
                             for (int k = 0; k < w; ++k) {
                                 if (mask[(v + h) * size + u + k] != val) {
@@ -238,68 +624,7 @@ void MeshBuilder::greedyMesh(std::shared_ptr<Chunk> chunk,
                         }
                     }
                     
-                    // Add quad
-                    Quad quad;
-                    if (w_axis == 0) {
-                        quad.x = ((nx > 0) ? d + 1 : d) * step; 
-                        quad.y = u * step; 
-                        quad.z = v * step;
-                    } else if (w_axis == 1) {
-                        quad.x = u * step; 
-                        quad.y = ((ny > 0) ? d + 1 : d) * step; 
-                        quad.z = v * step;
-                    } else {
-                        quad.x = u * step; 
-                        quad.y = v * step; 
-                        quad.z = ((nz > 0) ? d + 1 : d) * step;
-                    }
-                    
-                    quad.w = w * step; 
-                    quad.h = h * step;
-                    
-                    quad.u_axis = u_axis;
-                    quad.v_axis = v_axis;
-                    
-                    quad.nx = nx;
-                    quad.ny = ny;
-                    quad.nz = nz;
-                    
-                    quad.normal = Vertex::packNormal(nx, ny, nz);
-                    quad.material = material;
-                    quad.data = data;
-                    
-                    // Calculate AO
-                    // For LOD > 0, we can simplify AO or just sample at corners
-                    // We'll use the same logic but with 'step' for neighbor checks
-                    
-                    int u_vec[3] = {0}; u_vec[u_axis] = step;
-                    int v_vec[3] = {0}; v_vec[v_axis] = step;
-                    int n_vec[3] = {nx * step, ny * step, nz * step};
-                    int neg_u[3] = {-u_vec[0], -u_vec[1], -u_vec[2]};
-                    int neg_v[3] = {-v_vec[0], -v_vec[1], -v_vec[2]};
-                    
-                    // V0: (0, 0) -> Block (0, 0), check -u, -v
-                    quad.ao[0] = calculateVertexAO(chunk, quad.x, quad.y, quad.z, neg_u, neg_v, neighbors);
-                    
-                    // V1: (w, 0) -> Block (w-1, 0), check +u, -v
-                    int bx = quad.x + (quad.w - step)*u_vec[0]/step;
-                    int by = quad.y + (quad.w - step)*u_vec[1]/step;
-                    int bz = quad.z + (quad.w - step)*u_vec[2]/step;
-                    quad.ao[1] = calculateVertexAO(chunk, bx, by, bz, u_vec, neg_v, neighbors);
-                    
-                    // V2: (w, h) -> Block (w-1, h-1), check +u, +v
-                    bx = quad.x + (quad.w - step)*u_vec[0]/step + (quad.h - step)*v_vec[0]/step;
-                    by = quad.y + (quad.w - step)*u_vec[1]/step + (quad.h - step)*v_vec[1]/step;
-                    bz = quad.z + (quad.w - step)*u_vec[2]/step + (quad.h - step)*v_vec[2]/step;
-                    quad.ao[2] = calculateVertexAO(chunk, bx, by, bz, u_vec, v_vec, neighbors);
-                    
-                    // V3: (0, h) -> Block (0, h-1), check -u, +v
-                    bx = quad.x + (quad.h - step)*v_vec[0]/step;
-                    by = quad.y + (quad.h - step)*v_vec[1]/step;
-                    bz = quad.z + (quad.h - step)*v_vec[2]/step;
-                    quad.ao[3] = calculateVertexAO(chunk, bx, by, bz, neg_u, v_vec, neighbors);
-                    
-                    addQuad(quad, meshData);
+                    emitQuad(volume, meshData, dir, d, u, v, w, h, material, data, step);
                     
                     u += w;
                 }
@@ -308,21 +633,153 @@ void MeshBuilder::greedyMesh(std::shared_ptr<Chunk> chunk,
     }
 }
 
-bool MeshBuilder::isBlockSolid(std::shared_ptr<Chunk> chunk, int x, int y, int z,
-                                std::shared_ptr<Chunk> neighbors[6]) {
-    // Check in neighbor chunks if out of bounds
-    if (x < 0 && neighbors[1]) return neighbors[1]->getBlock(x + CHUNK_SIZE, y, z).isOpaque();
-    if (x >= CHUNK_SIZE && neighbors[0]) return neighbors[0]->getBlock(x - CHUNK_SIZE, y, z).isOpaque();
-    if (y < 0 && neighbors[3]) return neighbors[3]->getBlock(x, y + CHUNK_HEIGHT, z).isOpaque();
-    if (y >= CHUNK_HEIGHT && neighbors[2]) return neighbors[2]->getBlock(x, y - CHUNK_HEIGHT, z).isOpaque();
-    if (z < 0 && neighbors[5]) return neighbors[5]->getBlock(x, y, z + CHUNK_SIZE).isOpaque();
-    if (z >= CHUNK_SIZE && neighbors[4]) return neighbors[4]->getBlock(x, y, z - CHUNK_SIZE).isOpaque();
-    
-    if (x >= 0 && x < CHUNK_SIZE && y >= 0 && y < CHUNK_HEIGHT && z >= 0 && z < CHUNK_SIZE) {
-        return chunk->getBlock(x, y, z).isOpaque();
+void MeshBuilder::binaryGreedyMesh(const PaddedVolume& volume, MeshData& meshData, SegmentBuild* build) {
+    static_assert(CHUNK_SIZE == CHUNK_HEIGHT && CHUNK_SIZE <= 16, "face rows are 16-bit");
+    constexpr int P = CHUNK_SIZE + 2;
+    constexpr u32 ROW_MASK = (1u << CHUNK_SIZE) - 1;
+
+    // Padded occupancy rows per plane, bit i = coordinate i - 1:
+    // xRows[plane][y][z] run along x, yRows[plane][x][z] along y
+    u32 xRows[PLANE_COUNT][P][P] = {};
+    u32 yRows[PLANE_COUNT][P][P] = {};
+    const Block* block = volume.blocks.data();
+    for (int y = 0; y < P; ++y) {
+        for (int z = 0; z < P; ++z) {
+            for (int x = 0; x < P; ++x, ++block) {
+                int plane = facePlaneOf(*block);
+                if (plane < 0) continue;
+                xRows[plane][y][z] |= 1u << x;
+                yRows[plane][x][z] |= 1u << y;
+            }
+        }
     }
 
-    return false;
+    // Faces of one slice grouped by merge key (material + data), one bit row per v
+    struct KeyPlane {
+        u16 key;
+        u16 rows[CHUNK_SIZE];
+    };
+    std::array<KeyPlane, CHUNK_SIZE * CHUNK_SIZE> keyPlanes;
+    u8 keyIndex[CHUNK_SIZE][CHUNK_SIZE];
+
+    for (int dir = 0; dir < 6; ++dir) {
+        meshData.faceGroups[dir] = static_cast<u32>(meshData.vertices.size());
+        const int* n = FACE_DIRS[dir];
+        int step = n[0] + n[1] + n[2]; // +1 / -1 along the sweep axis
+        int u_axis = FACE_AXES[dir][0];
+        int v_axis = FACE_AXES[dir][1];
+        int w_axis = FACE_AXES[dir][2];
+
+        // Row of a plane in padded slice s, padded row r; bits run along u
+        auto row = [&](int plane, int s, int r) -> u32 {
+            if (w_axis == 0) return yRows[plane][s][r];
+            if (w_axis == 1) return xRows[plane][s][r];
+            return xRows[plane][r][s];
+        };
+        auto blockAt = [&](int d, int u, int v) -> Block {
+            int p[3];
+            p[w_axis] = d;
+            p[u_axis] = u;
+            p[v_axis] = v;
+            return volume.get(p[0], p[1], p[2]);
+        };
+
+        for (int d = 0; d < CHUNK_SIZE; ++d) {
+            if (!beginSegment(meshData, build, dir * CHUNK_SIZE + d, build && (build->dirty[dir] >> d & 1u))) continue;
+            int s = d + 1;
+            int sn = s + step;
+
+            // Visible faces per row: the block owns a face and the neighbor doesn't hide it
+            u16 faces[CHUNK_SIZE];
+            u32 anyFaces = 0;
+            for (int v = 0; v < CHUNK_SIZE; ++v) {
+                int r = v + 1;
+                u32 opaque = row(PLANE_OPAQUE, s, r), opaqueN = row(PLANE_OPAQUE, sn, r);
+                u32 water = row(PLANE_WATER, s, r), waterN = row(PLANE_WATER, sn, r);
+                u32 ice = row(PLANE_ICE, s, r), iceN = row(PLANE_ICE, sn, r);
+                u32 leaves = row(PLANE_LEAVES, s, r), leavesN = row(PLANE_LEAVES, sn, r);
+
+                u32 visible = (opaque & ~opaqueN) |
+                              (ice & ~opaqueN & ~iceN) |
+                              (leaves & ~opaqueN & ~leavesN) |
+                              (water & ~waterN & ~opaqueN & ~iceN);
+                u32 rowFaces = (visible >> 1) & ROW_MASK;
+
+                // Water next to water: side faces only where the level drops
+                if (w_axis != 1) {
+                    u32 touching = ((water & waterN) >> 1) & ROW_MASK;
+                    while (touching) {
+                        int u = std::countr_zero(touching);
+                        touching &= touching - 1;
+                        if (blockAt(d, u, v).getData() < blockAt(d + step, u, v).getData()) rowFaces |= 1u << u;
+                    }
+                }
+                faces[v] = static_cast<u16>(rowFaces);
+                anyFaces |= rowFaces;
+            }
+            if (!anyFaces) continue;
+
+            // Split the faces by merge key
+            size_t keyCount = 0;
+            size_t last = 0;
+            for (int v = 0; v < CHUNK_SIZE; ++v) {
+                for (u32 bits = faces[v]; bits; bits &= bits - 1) {
+                    int u = std::countr_zero(bits);
+                    Block face = blockAt(d, u, v);
+                    u8 data = face.getData();
+                    // Waterfall flag, as in greedyMesh
+                    if (face.isWater()) {
+                        int p[3];
+                        p[w_axis] = d;
+                        p[u_axis] = u;
+                        p[v_axis] = v;
+                        if (volume.get(p[0], p[1] + 1, p[2]).isWater()) data |= 0x20;
+                    }
+                    u16 key = static_cast<u16>((static_cast<u16>(data) << 8) | face.getMaterialID());
+
+                    if (keyCount == 0 || keyPlanes[last].key != key) {
+                        last = 0;
+                        while (last < keyCount && keyPlanes[last].key != key) ++last;
+                        if (last == keyCount) {
+                            keyPlanes[keyCount].key = key;
+                            std::fill(std::begin(keyPlanes[keyCount].rows), std::end(keyPlanes[keyCount].rows), static_cast<u16>(0));
+                            ++keyCount;
+                        }
+                    }
+                    keyPlanes[last].rows[v] |= static_cast<u16>(1u << u);
+                    keyIndex[v][u] = static_cast<u8>(last);
+                }
+            }
+
+            // Merge in the same row-major order as greedyMesh: widest run of the key along u,
+            // then grow along v while the next row holds the whole run
+            for (int v = 0; v < CHUNK_SIZE; ++v) {
+                while (faces[v]) {
+                    int u = std::countr_zero(static_cast<u32>(faces[v]));
+                    KeyPlane& plane = keyPlanes[keyIndex[v][u]];
+                    u8 material = static_cast<u8>(plane.key & 0xFF);
+                    u8 data = static_cast<u8>(plane.key >> 8);
+
+                    int w = 1;
+                    int h = 1;
+                    // Flowing water stays 1x1, as in greedyMesh
+                    if (material != static_cast<u8>(BlockType::WATER) || (data & 0x0F) == 0) {
+                        w = std::countr_one(static_cast<u32>(plane.rows[v]) >> u);
+                        u32 run = ((1u << w) - 1) << u;
+                        while (v + h < CHUNK_SIZE && (plane.rows[v + h] & run) == run) ++h;
+                    }
+
+                    u16 run = static_cast<u16>(((1u << w) - 1) << u);
+                    for (int l = 0; l < h; ++l) {
+                        plane.rows[v + l] &= ~run;
+                        faces[v + l] &= ~run;
+                    }
+
+                    emitQuad(volume, meshData, dir, d, u, v, w, h, material, data, 1);
+                }
+            }
+        }
+    }
 }
 
 void MeshBuilder::addQuad(const Quad& quad, MeshData& meshData) {
@@ -332,11 +789,8 @@ void MeshBuilder::addQuad(const Quad& quad, MeshData& meshData) {
     // Render water and ice as transparent
     bool isTransparent = isWater || isIce;
     
-    // Use appropriate vertex/index list
+    // Use appropriate vertex list
     auto& vertices = isTransparent ? meshData.waterVertices : meshData.vertices;
-    auto& indices = isTransparent ? meshData.waterIndices : meshData.indices;
-    
-    u32 baseIdx = static_cast<u32>(vertices.size());
     
     auto getPos = [&](int u, int v) {
         int px = quad.x;
@@ -366,6 +820,13 @@ void MeshBuilder::addQuad(const Quad& quad, MeshData& meshData) {
     u8 data3 = quad.data;
 
     if (isWater) {
+        // Per-corner levels; bit 6 (0x40) keeps "flowing" for the whole face (texture scroll)
+        u8 flags = (quad.data & 0xF0) | ((quad.data & 0x0F) != 0 ? 0x40 : 0);
+        data0 = flags | quad.levels[0];
+        data1 = flags | quad.levels[1];
+        data2 = flags | quad.levels[2];
+        data3 = flags | quad.levels[3];
+
         // Check if this is a waterfall block (has water above)
         // Bit 5 (0x20) is set in greedyMesh if so
         bool isWaterfall = (quad.data & 0x20) != 0;
@@ -394,10 +855,12 @@ void MeshBuilder::addQuad(const Quad& quad, MeshData& meshData) {
     u16 uv11 = Vertex::packUV(quad.w, quad.h);
     u16 uv01 = Vertex::packUV(0, quad.h);
     
-    vertices.emplace_back(x0, y0, z0, quad.normal, quad.material, uv00, quad.ao[0], data0);
-    vertices.emplace_back(x1, y1, z1, quad.normal, quad.material, uv10, quad.ao[1], data1);
-    vertices.emplace_back(x2, y2, z2, quad.normal, quad.material, uv11, quad.ao[2], data2);
-    vertices.emplace_back(x3, y3, z3, quad.normal, quad.material, uv01, quad.ao[3], data3);
+    const Vertex corners[4] = {
+        Vertex(x0, y0, z0, quad.normal, quad.material, uv00, quad.ao[0], data0),
+        Vertex(x1, y1, z1, quad.normal, quad.material, uv10, quad.ao[1], data1),
+        Vertex(x2, y2, z2, quad.normal, quad.material, uv11, quad.ao[2], data2),
+        Vertex(x3, y3, z3, quad.normal, quad.material, uv01, quad.ao[3], data3)
+    };
     
     // Winding order
     // Determine winding order based on face normal
@@ -407,64 +870,33 @@ void MeshBuilder::addQuad(const Quad& quad, MeshData& meshData) {
     // Determine triangulation split based on AO
     // Connect vertices with highest AO (brightest) to avoid dark creases
     // AO values: 0 (darkest) to 3 (brightest)
-    // We want to split along the diagonal that connects the two vertices with the most similar AO?
-    // Or the diagonal that avoids cutting through a shadow?
     // Standard voxel AO trick: if (ao0 + ao2 < ao1 + ao3) flip
     bool flipSplit = (quad.ao[0] + quad.ao[2]) < (quad.ao[1] + quad.ao[3]);
     
-    if (reverseWinding) {
-        if (flipSplit) {
-            // Connect 1-3, CW winding
-            indices.push_back(baseIdx + 1);
-            indices.push_back(baseIdx + 0);
-            indices.push_back(baseIdx + 3);
-            
-            indices.push_back(baseIdx + 3);
-            indices.push_back(baseIdx + 2);
-            indices.push_back(baseIdx + 1);
-        } else {
-            // Connect 0-2, CW winding
-            indices.push_back(baseIdx + 0);
-            indices.push_back(baseIdx + 2);
-            indices.push_back(baseIdx + 1);
-            
-            indices.push_back(baseIdx + 0);
-            indices.push_back(baseIdx + 3);
-            indices.push_back(baseIdx + 2);
-        }
-    } else {
-        if (flipSplit) {
-            // Connect 1-3, CCW winding
-            indices.push_back(baseIdx + 0);
-            indices.push_back(baseIdx + 1);
-            indices.push_back(baseIdx + 3);
-            
-            indices.push_back(baseIdx + 1);
-            indices.push_back(baseIdx + 2);
-            indices.push_back(baseIdx + 3);
-        } else {
-            // Connect 0-2, CCW winding
-            indices.push_back(baseIdx + 0);
-            indices.push_back(baseIdx + 1);
-            indices.push_back(baseIdx + 2);
-            
-            indices.push_back(baseIdx + 0);
-            indices.push_back(baseIdx + 2);
-            indices.push_back(baseIdx + 3);
-        }
+    // Every quad is drawn with the shared 0-1-2 / 0-2-3 pattern, so winding and split are
+    // encoded in the order the corners are emitted: the split diagonal runs from the first
+    // to the third vertex
+    static const int ORDER[4][4] = {
+        {0, 1, 2, 3}, // CCW, split 0-2
+        {1, 2, 3, 0}, // CCW, split 1-3
+        {0, 3, 2, 1}, // CW, split 0-2
+        {1, 0, 3, 2}  // CW, split 1-3
+    };
+    const int* order = ORDER[(reverseWinding ? 2 : 0) + (flipSplit ? 1 : 0)];
+    for (int i = 0; i < 4; ++i) {
+        vertices.push_back(corners[order[i]]);
     }
 }
 
-u8 MeshBuilder::calculateVertexAO(std::shared_ptr<Chunk> chunk, int x, int y, int z, 
-                                 const int* u_vec, const int* v_vec,
-                                 std::shared_ptr<Chunk> neighbors[6]) {
+u8 MeshBuilder::calculateVertexAO(const PaddedVolume& volume, int x, int y, int z, 
+                                 const int* u_vec, const int* v_vec) const {
     // Check 3 neighbors: Side1 (u), Side2 (v), Corner (u+v)
     // x,y,z is the block inside the quad.
     // u_vec, v_vec are directions to neighbors.
     
-    bool s1 = isBlockSolid(chunk, x + u_vec[0], y + u_vec[1], z + u_vec[2], neighbors);
-    bool s2 = isBlockSolid(chunk, x + v_vec[0], y + v_vec[1], z + v_vec[2], neighbors);
-    bool c = isBlockSolid(chunk, x + u_vec[0] + v_vec[0], y + u_vec[1] + v_vec[1], z + u_vec[2] + v_vec[2], neighbors);
+    bool s1 = isBlockSolid(volume, x + u_vec[0], y + u_vec[1], z + u_vec[2]);
+    bool s2 = isBlockSolid(volume, x + v_vec[0], y + v_vec[1], z + v_vec[2]);
+    bool c = isBlockSolid(volume, x + u_vec[0] + v_vec[0], y + u_vec[1] + v_vec[1], z + u_vec[2] + v_vec[2]);
     
     if (s1 && s2) return 0;
     return 3 - (s1 + s2 + c);
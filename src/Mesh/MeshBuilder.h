@@ -1,45 +1,142 @@
 #pragma once
 
 #include "../Util/Types.h"
+#include "../Util/Config.h"
 #include "../World/Chunk.h"
 #include "Vertex.h"
+#include <algorithm>
+#include <array>
 #include <vector>
 #include <memory>
+#include <atomic>
+#include <mutex>
 
+// Chunk meshes are plain quad lists: every 4 vertices are one quad, emitted in the order
+// the shared quad index pattern (0-1-2, 0-2-3, see QuadIndexBuffer) draws it, so there
+// are no per-chunk indices
 struct MeshData {
     std::vector<Vertex> vertices;
-    std::vector<u32> indices;
     std::vector<Vertex> waterVertices;
-    std::vector<u32> waterIndices;
+
+    // Opaque quads are grouped by face direction (X+, X-, Y+, Y-, Z+, Z-) with the cross
+    // models last: group i is vertices [faceGroups[i], faceGroups[i + 1])
+    std::array<u32, 8> faceGroups = {};
+    // Chunk-local bounds of all vertices, opaque and water
+    glm::vec3 boundsMin = glm::vec3(0.0f);
+    glm::vec3 boundsMax = glm::vec3(0.0f);
     
     void clear() {
         vertices.clear();
-        indices.clear();
         waterVertices.clear();
-        waterIndices.clear();
+        faceGroups.fill(0);
+        boundsMin = boundsMax = glm::vec3(0.0f);
     }
     
     bool isEmpty() const {
         return vertices.empty() && waterVertices.empty();
     }
+
+    size_t capacity() const {
+        return vertices.capacity() + waterVertices.capacity();
+    }
+};
+
+enum class MeshingAlgorithm {
+    GREEDY,  // Per-voxel mask sweep (any LOD)
+    BINARY   // Row bitmasks + bit scans at LOD 0, same quads as GREEDY; other LODs use GREEDY
 };
 
 class MeshBuilder {
 public:
-    MeshBuilder() = default;
+    MeshBuilder();
     ~MeshBuilder() = default;
 
-    // Build mesh with greedy meshing
-    MeshData buildChunkMesh(std::shared_ptr<Chunk> chunk, 
-                           std::shared_ptr<Chunk> chunkXPos,
-                           std::shared_ptr<Chunk> chunkXNeg,
-                           std::shared_ptr<Chunk> chunkYPos,
-                           std::shared_ptr<Chunk> chunkYNeg,
-                           std::shared_ptr<Chunk> chunkZPos,
-                           std::shared_ptr<Chunk> chunkZNeg,
-                           int lod = 0);
+    void setAlgorithm(MeshingAlgorithm value) { algorithm.store(value, std::memory_order_relaxed); }
+    MeshingAlgorithm getAlgorithm() const { return algorithm.load(std::memory_order_relaxed); }
+
+    // Build mesh with greedy meshing (the chunk is neighborhood[NEIGHBORHOOD_CENTER])
+    MeshData buildChunkMesh(const ChunkNeighborhood& neighborhood, int lod = 0);
+
+    // Hands the buffers of an uploaded mesh back to the pool (any thread). Meshes are
+    // built into pooled buffers reserved from the chunk's previous mesh size, so once the
+    // pool is warm, steady-state meshing does no heap allocation.
+    void recycle(MeshData&& meshData);
+
+    // Buffer pool stats: meshes built into pooled / fresh buffers, and builds that still
+    // had to grow a buffer past its reservation
+    u64 getPooledBuffers() const { return pooledBuffers.load(std::memory_order_relaxed); }
+    u64 getFreshBuffers() const { return freshBuffers.load(std::memory_order_relaxed); }
+    u64 getBufferGrowths() const { return bufferGrowths.load(std::memory_order_relaxed); }
+
+    // Incremental re-mesh stats: LOD 0 builds that reused a cached mesh, and slices re-meshed / copied
+    u64 getIncrementalBuilds() const { return incrementalBuilds.load(std::memory_order_relaxed); }
+    u64 getSlicesRebuilt() const { return slicesRebuilt.load(std::memory_order_relaxed); }
+    u64 getSlicesReused() const { return slicesReused.load(std::memory_order_relaxed); }
+
+    // Uniform-chunk fast path stats
+    u64 getUniformAirSkipped() const { return uniformAirSkipped.load(std::memory_order_relaxed); }
+    u64 getEnclosedSolidSkipped() const { return enclosedSolidSkipped.load(std::memory_order_relaxed); }
 
 private:
+    // The chunk plus a one-block border taken from all 26 neighbors, copied once
+    // per mesh so the mesher never branches on chunk boundaries or touches live
+    // chunk data. Missing neighbors read as air. Coordinates run from -1 to
+    // CHUNK_SIZE / CHUNK_HEIGHT; lookups further out (LOD steps) clamp to the border.
+    // For LOD > 0 every block holds its chunk's mip cell (Chunk::copyMipLevel), so the
+    // mesher's samples at LOD steps see the downsampled blocks.
+    struct PaddedVolume {
+        static constexpr int SIZE_X = CHUNK_SIZE + 2;
+        static constexpr int SIZE_Y = CHUNK_HEIGHT + 2;
+        static constexpr int SIZE_Z = CHUNK_SIZE + 2;
+
+        std::array<Block, SIZE_X * SIZE_Y * SIZE_Z> blocks;
+
+        void fill(const ChunkNeighborhood& neighborhood, int lod);
+
+        Block get(int x, int y, int z) const {
+            x = std::clamp(x, -1, CHUNK_SIZE);
+            y = std::clamp(y, -1, CHUNK_HEIGHT);
+            z = std::clamp(z, -1, CHUNK_SIZE);
+            return blocks[((y + 1) * SIZE_Z + (z + 1)) * SIZE_X + (x + 1)];
+        }
+    };
+
+    // A LOD 0 mesh is emitted in segments: segment dir * CHUNK_SIZE + d holds the faces of
+    // slice d in direction dir, the last one the cross models. Faces of a slice only depend
+    // on the blocks of that slice and the two next to it, so after an edit every other
+    // segment can be copied from the previous mesh instead of re-meshed.
+    static constexpr int SEGMENT_COUNT = 6 * CHUNK_SIZE + 1;
+    static constexpr int CROSS_SEGMENT = SEGMENT_COUNT - 1;
+
+    struct SegmentStart {
+        u32 vertices, waterVertices;
+    };
+    using Segments = std::array<SegmentStart, SEGMENT_COUNT + 1>; // Last entry = end of the mesh
+
+    // Last LOD 0 mesh of a chunk and the volume it was built from
+    struct CachedMesh {
+        ChunkPos pos{0};
+        PaddedVolume volume;
+        MeshData meshData;
+        Segments segments;
+        u64 lastUse = 0;
+    };
+
+    struct SegmentBuild {
+        Segments segments;
+        const CachedMesh* previous = nullptr; // Null: every segment is meshed
+        u32 dirty[6] = {};                    // Per direction, bit d = slice d changed
+        bool crossesDirty = true;
+    };
+
+    // Records where a segment starts; false if it was copied from the previous mesh instead
+    bool beginSegment(MeshData& meshData, SegmentBuild* build, int segment, bool dirty);
+    void findDirtySlices(const PaddedVolume& volume, SegmentBuild& build) const;
+    std::unique_ptr<CachedMesh> takeCachedMesh(const ChunkPos& pos);
+    void storeCachedMesh(const ChunkPos& pos, std::unique_ptr<CachedMesh> cached, const PaddedVolume& volume,
+                         const MeshData& meshData, const Segments& segments);
+    void releaseCachedMesh(std::unique_ptr<CachedMesh> cached);
+
     struct Quad {
         int x, y, z;
         int w, h;
@@ -49,21 +146,58 @@ private:
         u8 material;
         u8 data; // Metadata
         u8 ao[4]; // AO for each vertex
+        u8 levels[4]; // Water level for each vertex (see waterCornerLevel)
     };
     
-    void greedyMesh(std::shared_ptr<Chunk> chunk,
-                   std::shared_ptr<Chunk> neighbors[6],
+    void greedyMesh(const PaddedVolume& volume,
                    MeshData& meshData,
-                   int lod);
+                   int lod,
+                   SegmentBuild* build = nullptr); // LOD 0 only
+    void binaryGreedyMesh(const PaddedVolume& volume, MeshData& meshData, SegmentBuild* build = nullptr);
+
+    // Builds the quad for a merged w x h face run (slice d, origin u/v) including its AO
+    void emitQuad(const PaddedVolume& volume, MeshData& meshData, int dir,
+                  int d, int u, int v, int w, int h, u8 material, u8 data, int step);
     
-    bool isBlockSolid(std::shared_ptr<Chunk> chunk, int x, int y, int z,
-                     std::shared_ptr<Chunk> neighbors[6]);
+    bool isBlockSolid(const PaddedVolume& volume, int x, int y, int z) const {
+        return volume.get(x, y, z).isOpaque();
+    }
                      
-    u8 calculateVertexAO(std::shared_ptr<Chunk> chunk, int x, int y, int z, 
-                        const int* u, const int* v,
-                        std::shared_ptr<Chunk> neighbors[6]);
+    u8 calculateVertexAO(const PaddedVolume& volume, int x, int y, int z, 
+                        const int* u, const int* v) const;
     
+    // Water level of the vertical edge at (x, z) in layer y: the highest of the (up to four)
+    // water columns around it, so every quad touching that corner gets the same surface height
+    static u8 waterCornerLevel(const PaddedVolume& volume, int x, int y, int z, int step);
+
     void addQuad(const Quad& quad, MeshData& meshData);
+    static void computeBounds(MeshData& meshData);
     
     void addCross(int x, int y, int z, u8 material, u8 ao, MeshData& meshData);
+
+    // Pooled buffers (or fresh ones), cleared and reserved for the hinted size
+    MeshData acquireBuffers(const Chunk::MeshSizeHint& hint);
+
+    // Uniform opaque chunk whose six neighbors all cover it with opaque faces
+    bool isEnclosed(const ChunkNeighborhood& neighborhood) const;
+
+    std::atomic<MeshingAlgorithm> algorithm{MeshingAlgorithm::BINARY};
+    std::atomic<u64> uniformAirSkipped{0};
+    std::atomic<u64> enclosedSolidSkipped{0};
+
+    std::mutex poolMutex;
+    std::vector<MeshData> bufferPool;
+    std::atomic<u64> pooledBuffers{0};
+    std::atomic<u64> freshBuffers{0};
+    std::atomic<u64> bufferGrowths{0};
+
+    // LOD 0 meshes of just-edited chunks, plus released entries kept for reuse; together
+    // at most MESH_CACHE_SIZE (least recently used evicted), both reserved up front
+    std::mutex cacheMutex;
+    std::vector<std::unique_ptr<CachedMesh>> meshCache;
+    std::vector<std::unique_ptr<CachedMesh>> spareMeshes;
+    u64 cacheClock = 0;
+    std::atomic<u64> incrementalBuilds{0};
+    std::atomic<u64> slicesRebuilt{0};
+    std::atomic<u64> slicesReused{0};
 };
@@ -19,6 +19,7 @@ bool Renderer::initialize(int windowWidth, int windowHeight) {
         return false;
     }
     
+    quadIndices = std::make_unique<QuadIndexBuffer>(MAX_CHUNK_QUADS);
     initCrosshair();
     initSun();
     initStars();
@@ -133,11 +134,15 @@ void Renderer::render(ChunkManager& chunkManager, Camera& camera, const std::vec
 
             if (!shouldRender) continue;
 
+            // Chunks without geometry (uniform air, enclosed solid) skip the frustum test
+            auto it = chunkMeshes.find(pos);
+            if (it == chunkMeshes.end() || !it->second->isUploaded()) continue;
+
             // Compute chunk position relative to render origin (same space as cameraRelative / lightSpaceMatrix)
             glm::vec3 chunkWorldPos = ChunkManager::chunkToWorld(pos);
             glm::vec3 chunkRelativePos = chunkWorldPos - glm::vec3(renderOrigin);
-            glm::vec3 chunkMin = chunkRelativePos;
-            glm::vec3 chunkMax = chunkRelativePos + glm::vec3(CHUNK_SIZE, CHUNK_HEIGHT, CHUNK_SIZE);
+            glm::vec3 chunkMin = chunkRelativePos + it->second->getBoundsMin();
+            glm::vec3 chunkMax = chunkRelativePos + it->second->getBoundsMax();
 
             // If this chunk was uploaded very recently, force it into shadow pass for a few frames to ensure it contributes
             auto itUploaded = lastUploadedFrame.find(pos);
@@ -148,16 +153,13 @@ void Renderer::render(ChunkManager& chunkManager, Camera& camera, const std::vec
                 }
             }
 
-            auto it = chunkMeshes.find(pos);
-            if (it != chunkMeshes.end() && it->second->isUploaded()) {
-                glm::mat4 model = glm::translate(glm::mat4(1.0f), chunkRelativePos);
-                shadowShader.setMat4("uModel", model);
+            glm::mat4 model = glm::translate(glm::mat4(1.0f), chunkRelativePos);
+            shadowShader.setMat4("uModel", model);
 
-                it->second->bind();
-                it->second->draw();
-                it->second->unbind();
-                ++shadowDrawCalls;
-            }
+            it->second->bind();
+            it->second->draw();
+            it->second->unbind();
+            ++shadowDrawCalls;
         }
 
         // Restore state
@@ -311,6 +313,9 @@ void Renderer::render(ChunkManager& chunkManager, Camera& camera, const std::vec
     blockShader.setVec3("uSkyColor", skyColor);
 
     int chunksRendered = 0;
+    uniformChunksSkipped = 0;
+    indicesDrawn = 0;
+    indicesTotal = 0;
     // const auto& chunks = chunkManager.getChunks(); // Already got this above
     
     for (const auto& [pos, chunk] : chunks) {
@@ -331,31 +336,47 @@ void Renderer::render(ChunkManager& chunkManager, Camera& camera, const std::vec
         
         if (!shouldRender) continue;
         
+        // Uniform air / enclosed solid chunks have no mesh: skip them before the frustum test
+        auto it = chunkMeshes.find(pos);
+        if (it == chunkMeshes.end() || !it->second->isUploaded()) {
+            if (chunk->isUniform()) uniformChunksSkipped++;
+            continue;
+        }
+        
         // Calculate chunk position relative to render origin
         glm::vec3 chunkWorldPos = ChunkManager::chunkToWorld(pos);
         glm::vec3 chunkRelativePos = chunkWorldPos - originOffset; // Camera-relative chunk position
         
-        // Frustum culling (use relative positions for consistency with view matrix)
-        glm::vec3 chunkMin = chunkRelativePos;
-        glm::vec3 chunkMax = chunkRelativePos + glm::vec3(CHUNK_SIZE, CHUNK_HEIGHT, CHUNK_SIZE);
+        // Frustum culling against the mesh's tight bounds (relative positions, consistent with the view matrix)
+        const Mesh& mesh = *it->second;
+        glm::vec3 chunkMin = chunkRelativePos + mesh.getBoundsMin();
+        glm::vec3 chunkMax = chunkRelativePos + mesh.getBoundsMax();
         
         if (!frustum.isBoxVisible(chunkMin, chunkMax)) {
             continue;
         }
+
+        // Back-face culling per direction group: a face can only be seen from the side its
+        // normal points to, so skip groups whose every face plane lies behind the camera
+        glm::vec3 eye = cameraRelative - chunkRelativePos;
+        u32 groups = 1u << 6; // Cross models are double sided
+        if (eye.x > mesh.getBoundsMin().x) groups |= 1u << 0;
+        if (eye.x < mesh.getBoundsMax().x) groups |= 1u << 1;
+        if (eye.y > mesh.getBoundsMin().y) groups |= 1u << 2;
+        if (eye.y < mesh.getBoundsMax().y) groups |= 1u << 3;
+        if (eye.z > mesh.getBoundsMin().z) groups |= 1u << 4;
+        if (eye.z < mesh.getBoundsMax().z) groups |= 1u << 5;
         
-        // Get or create mesh
-        auto it = chunkMeshes.find(pos);
-        if (it != chunkMeshes.end() && it->second->isUploaded()) {
-            // Use camera-relative position for model matrix
-            glm::mat4 model = glm::translate(glm::mat4(1.0f), chunkRelativePos);
-            blockShader.setMat4("uModel", model);
-            
-            it->second->bind();
-            it->second->draw();
-            it->second->unbind();
-            
-            chunksRendered++;
-        }
+        // Use camera-relative position for model matrix
+        glm::mat4 model = glm::translate(glm::mat4(1.0f), chunkRelativePos);
+        blockShader.setMat4("uModel", model);
+        
+        mesh.bind();
+        indicesDrawn += mesh.drawFaceGroups(groups);
+        indicesTotal += mesh.getIndexCount();
+        mesh.unbind();
+        
+        chunksRendered++;
     }
     
     // Reset polygon mode back to fill if we switched to wireframe
@@ -451,26 +472,26 @@ void Renderer::render(ChunkManager& chunkManager, Camera& camera, const std::vec
         
         if (!shouldRender) continue;
         
+        auto it = waterMeshes.find(pos);
+        if (it == waterMeshes.end() || !it->second->isUploaded()) continue;
+        
         // Frustum culling (use camera-relative positions like other geometry)
         glm::vec3 chunkWorldPos = ChunkManager::chunkToWorld(pos);
         glm::vec3 chunkRelativePos = chunkWorldPos - originOffset; // camera-relative
-        glm::vec3 chunkMin = chunkRelativePos;
-        glm::vec3 chunkMax = chunkRelativePos + glm::vec3(CHUNK_SIZE, CHUNK_HEIGHT, CHUNK_SIZE);
+        // Tight bounds, padded for the vertex shader's waves
+        glm::vec3 chunkMin = chunkRelativePos + it->second->getBoundsMin() - glm::vec3(0.25f);
+        glm::vec3 chunkMax = chunkRelativePos + it->second->getBoundsMax() + glm::vec3(0.25f);
         
         if (!frustum.isBoxVisible(chunkMin, chunkMax)) {
             continue;
         }
         
-        // Get or create mesh
-        auto it = waterMeshes.find(pos);
-        if (it != waterMeshes.end() && it->second->isUploaded()) {
-            glm::mat4 model = glm::translate(glm::mat4(1.0f), chunkRelativePos);
-            waterShader.setMat4("uModel", model);
-            
-            it->second->bind();
-            it->second->draw();
-            it->second->unbind();
-        }
+        glm::mat4 model = glm::translate(glm::mat4(1.0f), chunkRelativePos);
+        waterShader.setMat4("uModel", model);
+        
+        it->second->bind();
+        it->second->draw();
+        it->second->unbind();
     }
     
     waterShader.unuse();
@@ -1225,9 +1246,9 @@ void Renderer::renderClouds(const Camera& camera, int windowWidth, int windowHei
 void Renderer::cleanUnusedMeshes(const ChunkManager& chunkManager) {
     const auto& chunks = chunkManager.getChunks();
     
-    // Clean chunk meshes
+    // Clean chunk meshes (parked chunks keep their blocks, not their meshes)
     for (auto it = chunkMeshes.begin(); it != chunkMeshes.end(); ) {
-        if (chunks.find(it->first) == chunks.end()) {
+        if (chunks.find(it->first) == chunks.end() || chunkManager.isChunkParked(it->first)) {
             it = chunkMeshes.erase(it);
         } else {
             ++it;
@@ -1236,7 +1257,7 @@ void Renderer::cleanUnusedMeshes(const ChunkManager& chunkManager) {
     
     // Clean water meshes
     for (auto it = waterMeshes.begin(); it != waterMeshes.end(); ) {
-        if (chunks.find(it->first) == chunks.end()) {
+        if (chunks.find(it->first) == chunks.end() || chunkManager.isChunkParked(it->first)) {
             it = waterMeshes.erase(it);
         } else {
             ++it;
@@ -1244,16 +1265,15 @@ void Renderer::cleanUnusedMeshes(const ChunkManager& chunkManager) {
     }
 }
 
-void Renderer::uploadChunkMesh(const ChunkPos& pos, 
-                              const std::vector<Vertex>& vertices, 
-                              const std::vector<u32>& indices,
-                              const std::vector<Vertex>& waterVertices,
-                              const std::vector<u32>& waterIndices) {
+void Renderer::uploadChunkMesh(const ChunkPos& pos, const MeshData& meshData) {
     // Opaque mesh
-    if (!vertices.empty() && !indices.empty()) {
-        auto mesh = std::make_unique<Mesh>();
-        mesh->upload(vertices, indices);
-        chunkMeshes[pos] = std::move(mesh);
+    if (!meshData.vertices.empty()) {
+        // Re-meshes reuse the chunk's existing VAO / buffers
+        auto& mesh = chunkMeshes[pos];
+        if (!mesh) mesh = std::make_unique<Mesh>();
+        mesh->uploadQuads(meshData.vertices, *quadIndices);
+        mesh->setFaceGroups(meshData.faceGroups);
+        mesh->setBounds(meshData.boundsMin, meshData.boundsMax);
         // Record upload frame so shadow pass can include this chunk immediately for a few frames
         lastUploadedFrame[pos] = frameCounter;
     } else {
@@ -1262,13 +1282,28 @@ void Renderer::uploadChunkMesh(const ChunkPos& pos,
     }
     
     // Water mesh
-    if (!waterVertices.empty() && !waterIndices.empty()) {
-        auto mesh = std::make_unique<Mesh>();
-        mesh->upload(waterVertices, waterIndices);
-        waterMeshes[pos] = std::move(mesh);
+    if (!meshData.waterVertices.empty()) {
+        auto& mesh = waterMeshes[pos];
+        if (!mesh) mesh = std::make_unique<Mesh>();
+        mesh->uploadQuads(meshData.waterVertices, *quadIndices);
+        mesh->setBounds(meshData.boundsMin, meshData.boundsMax);
         lastUploadedFrame[pos] = frameCounter; // also mark
     } else {
         waterMeshes.erase(pos);
         lastUploadedFrame.erase(pos);
     }
 }
+
+size_t Renderer::getPerChunkIndexBytes() const {
+    size_t bytes = 0;
+    for (const auto* meshes : {&chunkMeshes, &waterMeshes}) {
+        for (const auto& [pos, mesh] : *meshes) {
+            bytes += mesh->getIndexCount() * sizeof(u32);
+        }
+    }
+    return bytes;
+}
+
+size_t Renderer::getSharedIndexBytes() const {
+    return quadIndices ? quadIndices->getMemoryUsage() : 0;
+}
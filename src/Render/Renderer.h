@@ -9,6 +9,7 @@
 #include "PostProcess.h"
 #include "../World/ChunkManager.h"
 #include "../Mesh/Mesh.h"
+#include "../Mesh/MeshBuilder.h"
 #include <memory>
 #include <unordered_map>
 #include <vector>
@@ -37,11 +38,7 @@ public:
     Shader& getModelShader() { return modelShader; }
     
     // Add mesh for a chunk
-    void uploadChunkMesh(const ChunkPos& pos, 
-                        const std::vector<Vertex>& vertices, 
-                        const std::vector<u32>& indices,
-                        const std::vector<Vertex>& waterVertices,
-                        const std::vector<u32>& waterIndices);
+    void uploadChunkMesh(const ChunkPos& pos, const MeshData& meshData);
 
     // Clean up meshes for chunks that are no longer in the ChunkManager
     void cleanUnusedMeshes(const ChunkManager& chunkManager);
@@ -57,6 +54,18 @@ public:
     // Access PostProcess for debug/metrics
     PostProcess* getPostProcess() { return postProcess.get(); }
 
+    // Uniform chunks the last frame skipped without a frustum test or draw
+    int getUniformChunksSkipped() const { return uniformChunksSkipped; }
+
+    // Opaque chunk indices the last frame drew after back-face group culling, out of those in visible chunks
+    size_t getIndicesDrawn() const { return indicesDrawn; }
+    size_t getIndicesTotal() const { return indicesTotal; }
+
+    // Index memory: what per-chunk u32 index buffers would hold for the loaded meshes,
+    // against the one shared quad index buffer they all draw with
+    size_t getPerChunkIndexBytes() const;
+    size_t getSharedIndexBytes() const;
+
 private:
     Shader blockShader;
     Shader waterShader;
@@ -81,8 +90,12 @@ private:
     Frustum frustum;
     Frustum shadowFrustum;
     
+    std::unique_ptr<QuadIndexBuffer> quadIndices; // Shared by every chunk and water mesh
     std::unordered_map<ChunkPos, std::unique_ptr<Mesh>> chunkMeshes;
     std::unordered_map<ChunkPos, std::unique_ptr<Mesh>> waterMeshes;
+    int uniformChunksSkipped = 0;
+    size_t indicesDrawn = 0;
+    size_t indicesTotal = 0;
     
     glm::vec3 lightDirection = glm::vec3(0.5f, 1.0f, 0.3f);
     glm::vec3 skyColor = glm::vec3(0.53f, 0.81f, 0.92f);
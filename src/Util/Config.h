@@ -1,20 +1,29 @@
 #pragma once
 
 #include <cstdint>
+#include <cstddef>
 
 // Chunk configuration
 constexpr int CHUNK_SIZE = 16;
 constexpr int CHUNK_HEIGHT = 16;
 constexpr int CHUNK_AREA = CHUNK_SIZE * CHUNK_SIZE;
 constexpr int CHUNK_VOLUME = CHUNK_SIZE * CHUNK_SIZE * CHUNK_HEIGHT;
+constexpr int CHUNK_MIP_LEVELS = 2;  // downsampled block levels kept per chunk, one per LOD above 0
 
 // Rendering configuration
 constexpr int RENDER_DISTANCE = 8;  // chunks
 constexpr int MAX_CHUNKS_PER_FRAME = 4;  // chunks to generate per frame
 constexpr int MAX_MESHES_PER_FRAME = 4;  // meshes to build per frame
+constexpr int CHUNK_MEMORY_BUDGET_MB = 256;  // resident chunk data before chunks out of range are evicted (settings.ini: chunkMemoryBudgetMB)
+constexpr double MESH_NEIGHBOR_TIMEOUT_SECONDS = 1.0;  // longest a chunk waits for generating neighbors before meshing anyway
+constexpr size_t MESH_BUFFER_POOL_SIZE = 64;  // uploaded mesh buffers kept for reuse by the meshers
+constexpr size_t MESH_CACHE_SIZE = 64;  // LOD 0 meshes of just-edited chunks kept for incremental re-meshing
+constexpr size_t CHUNK_POOL_MAX_FREE = 512;  // unloaded chunks kept by the chunk pool for reuse
+constexpr size_t MAX_CHUNK_QUADS = CHUNK_VOLUME * 6;  // quads per chunk mesh upper bound (shared index buffer size)
 
 // Thread pool configuration
 constexpr int THREAD_POOL_SIZE = 4;
+constexpr size_t MAX_CHUNK_JOBS_IN_FLIGHT = THREAD_POOL_SIZE * 2;  // chunk jobs handed to the pool at once
 
 // Camera configuration
 constexpr float FOV = 70.0f;
@@ -31,3 +40,14 @@ constexpr size_t RING_BUFFER_FRAMES = 3;
 constexpr float NOISE_SCALE = 0.01f;
 constexpr int TERRAIN_HEIGHT = 64;
 constexpr int SEA_LEVEL = 32;
+constexpr int MIN_CHUNK_Y = -4;  // lowest chunk of a column (bedrock floor)
+constexpr int MAX_CHUNK_Y = 12;  // highest chunk of a column
+constexpr size_t COLUMN_CACHE_SIZE = 2048;  // cached terrain columns (heightmap/biome/trees)
+
+// World storage
+constexpr int REGION_SIZE = 32;  // chunks per region file along each axis
+constexpr int REGION_VOLUME = REGION_SIZE * REGION_SIZE * REGION_SIZE;
+constexpr int REGION_SECTOR_SIZE = 256;  // chunk payloads are sector-aligned inside a region file
+constexpr float REGION_COMPACT_FREE_RATIO = 0.5f;  // region files are compacted once this share of their sectors is free
+constexpr int REGION_COMPACT_MIN_SECTORS = 256;  // ...and at least this many
+constexpr float AUTOSAVE_INTERVAL_SECONDS = 60.0f;  // background save of edited chunks while playing
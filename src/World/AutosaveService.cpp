@@ -0,0 +1,154 @@
+#include "AutosaveService.h"
+#include "ChunkCodec.h"
+#include "WorldSerializer.h"
+#include "../Core/Logger.h"
+#include <algorithm>
+#include <unordered_map>
+
+namespace {
+double millisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+}
+
+AutosaveService::AutosaveService(ChunkManager& chunkManager)
+    : chunkManager(chunkManager) {
+    ioThread = std::thread(&AutosaveService::ioLoop, this);
+}
+
+AutosaveService::~AutosaveService() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+    }
+    condition.notify_all();
+    // A queued save still runs before the thread exits
+    if (ioThread.joinable()) ioThread.join();
+}
+
+bool AutosaveService::requestSave(const std::string& worldName, const glm::vec3& playerPos, long seed) {
+    if (busy.load()) return false;
+
+    auto start = std::chrono::steady_clock::now();
+
+    // Saving under another name than the one that was loaded starts a new set of regions
+    auto storage = chunkManager.getRegionStorage();
+    if (!storage || storage->getDirectory() != WorldSerializer::getRegionDirectory(worldName)) {
+        storage = WorldSerializer::openRegionStorage(worldName, true);
+        chunkManager.setRegionStorage(storage);
+    }
+
+    auto job = std::make_unique<SaveJob>();
+    job->worldName = worldName;
+    job->playerPos = playerPos;
+    job->seed = seed;
+    job->storage = std::move(storage);
+    job->chunks = chunkManager.snapshotUnsavedChunks();
+    job->requested = start;
+
+    chunksQueued = job->chunks.size();
+    chunksDone = 0;
+    busy = true;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending = std::move(job);
+    }
+    condition.notify_one();
+
+    std::lock_guard<std::mutex> lock(statsMutex);
+    stats.lastSnapshotMs = millisecondsSince(start);
+    return true;
+}
+
+void AutosaveService::waitIdle() {
+    std::unique_lock<std::mutex> lock(mutex);
+    idleCondition.wait(lock, [this] { return !busy.load(); });
+}
+
+float AutosaveService::getProgress() const {
+    if (!busy.load()) return 1.0f;
+    size_t total = chunksQueued.load();
+    return total == 0 ? 0.0f : static_cast<float>(chunksDone.load()) / static_cast<float>(total);
+}
+
+AutosaveService::Stats AutosaveService::getStats() const {
+    std::lock_guard<std::mutex> lock(statsMutex);
+    Stats result = stats;
+    result.busy = busy.load();
+    result.chunksQueued = chunksQueued.load();
+    result.chunksDone = chunksDone.load();
+    return result;
+}
+
+void AutosaveService::ioLoop() {
+    while (true) {
+        std::unique_ptr<SaveJob> job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [this] { return stop || pending; });
+            if (!pending) return; // Stopping with nothing left to save
+            job = std::move(pending);
+        }
+
+        bool ok = runJob(*job);
+        double elapsed = millisecondsSince(job->requested);
+        {
+            std::lock_guard<std::mutex> lock(statsMutex);
+            if (ok) stats.savesCompleted++;
+            else stats.savesFailed++;
+            stats.lastSaveMs = elapsed;
+            stats.maxSaveMs = std::max(stats.maxSaveMs, elapsed);
+        }
+
+        if (ok) {
+            LOG_INFO("Saved world '" + job->worldName + "': " + std::to_string(job->chunks.size()) +
+                     " modified chunks in " + std::to_string(static_cast<int>(elapsed)) + " ms");
+        } else {
+            LOG_ERROR("Some chunks of world '" + job->worldName + "' could not be saved, retrying on the next save");
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            busy = false;
+        }
+        idleCondition.notify_all();
+    }
+}
+
+bool AutosaveService::runJob(SaveJob& job) {
+    bool ok = WorldSerializer::saveLevel(job.worldName, job.playerPos, job.seed);
+
+    // One batch per region: each is stored atomically and makes its chunks saved
+    std::unordered_map<glm::ivec3, std::vector<size_t>> byRegion;
+    for (size_t i = 0; i < job.chunks.size(); ++i) {
+        byRegion[RegionFile::regionOf(job.chunks[i].first)].push_back(i);
+    }
+
+    std::vector<Block> blocks(CHUNK_VOLUME);
+    std::vector<std::pair<ChunkPos, std::vector<u8>>> payloads;
+    std::vector<std::pair<ChunkPos, Chunk::Snapshot>> written;
+    for (const auto& [region, indices] : byRegion) {
+        payloads.clear();
+        written.clear();
+        u64 bytes = 0;
+        for (size_t i : indices) {
+            const auto& [pos, snapshot] = job.chunks[i];
+            snapshot.copyBlocks(blocks.data());
+            payloads.emplace_back(pos, std::vector<u8>());
+            ChunkCodec::encode(blocks.data(), payloads.back().second);
+            bytes += payloads.back().second.size();
+            written.emplace_back(pos, snapshot);
+        }
+
+        if (job.storage->writeChunks(payloads)) {
+            chunkManager.markChunksSaved(written);
+            std::lock_guard<std::mutex> lock(statsMutex);
+            stats.chunksWritten += written.size();
+            stats.bytesWritten += bytes;
+        } else {
+            ok = false;
+        }
+        chunksDone += indices.size();
+    }
+    return ok;
+}
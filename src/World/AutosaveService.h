@@ -0,0 +1,82 @@
+#pragma once
+
+#include "../Util/Types.h"
+#include "Chunk.h"
+#include "ChunkManager.h"
+#include "RegionFile.h"
+#include <atomic>
+#include <condition_variable>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Saves worlds on a background I/O thread so saving never stalls a frame.
+// requestSave (main thread) only takes copy-on-write snapshots of the modified
+// chunks; encoding, region writes and level.dat are done by the I/O thread.
+// Each region takes its batch atomically (see RegionFile), level.dat is replaced
+// with a temp file + rename, and a chunk leaves ChunkManager's unsaved set only
+// once its region is on disk, so a failed save is retried by the next one.
+class AutosaveService {
+public:
+    struct Stats {
+        bool busy = false;
+        size_t chunksQueued = 0;   // Chunks of the save in progress
+        size_t chunksDone = 0;
+        u64 savesCompleted = 0;
+        u64 savesFailed = 0;
+        u64 chunksWritten = 0;
+        u64 bytesWritten = 0;      // Encoded chunk payloads
+        double lastSnapshotMs = 0.0; // Main-thread cost of the last request
+        double lastSaveMs = 0.0;     // Request to completion
+        double maxSaveMs = 0.0;
+    };
+
+    explicit AutosaveService(ChunkManager& chunkManager);
+    ~AutosaveService();
+
+    AutosaveService(const AutosaveService&) = delete;
+    AutosaveService& operator=(const AutosaveService&) = delete;
+
+    // False if a save is still running (nothing is queued; try again later)
+    bool requestSave(const std::string& worldName, const glm::vec3& playerPos, long seed);
+
+    // Blocks until the running save has finished (world switch, shutdown)
+    void waitIdle();
+
+    bool isBusy() const { return busy.load(); }
+    float getProgress() const; // 0..1 for the running save, 1 when idle
+    Stats getStats() const;
+
+private:
+    struct SaveJob {
+        std::string worldName;
+        glm::vec3 playerPos;
+        long seed;
+        std::shared_ptr<RegionStorage> storage;
+        std::vector<std::pair<ChunkPos, Chunk::Snapshot>> chunks;
+        std::chrono::steady_clock::time_point requested;
+    };
+
+    void ioLoop();
+    bool runJob(SaveJob& job);
+
+    ChunkManager& chunkManager;
+
+    std::thread ioThread;
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::condition_variable idleCondition;
+    std::unique_ptr<SaveJob> pending; // At most one save queued or running
+    bool stop = false;
+
+    std::atomic<bool> busy{false};
+    std::atomic<size_t> chunksQueued{0};
+    std::atomic<size_t> chunksDone{0};
+
+    mutable std::mutex statsMutex;
+    Stats stats;
+};
@@ -0,0 +1,86 @@
+#include "BlockAccessor.h"
+#include "WorldGenerator.h"
+#include <algorithm>
+
+BlockAccessor::BlockAccessor(ChunkManager& chunkManager)
+    : chunkManager(chunkManager) {
+}
+
+const BlockAccessor::Entry& BlockAccessor::lookup(const ChunkPos& pos) {
+    // Consecutive reads mostly stay in one chunk
+    if (entries[lastEntry].used && entries[lastEntry].pos == pos) return entries[lastEntry];
+    for (int i = 0; i < CACHED_CHUNKS; ++i) {
+        if (entries[i].used && entries[i].pos == pos) {
+            lastEntry = i;
+            return entries[i];
+        }
+    }
+
+    Entry& entry = entries[nextEntry];
+    entry.pos = pos;
+    entry.chunk = chunkManager.chunks.find(pos);
+    entry.solid = !entry.chunk && chunkManager.getImplicitChunk(pos) == ChunkManager::ImplicitChunk::SOLID;
+    entry.used = true;
+    lastEntry = nextEntry;
+    nextEntry = (nextEntry + 1) % CACHED_CHUNKS;
+    return entry;
+}
+
+Block BlockAccessor::implicitBlock(const Entry& entry, int y) {
+    if (!entry.solid) return Block(BlockType::AIR);
+    return Block(y <= WorldGenerator::BEDROCK_Y ? BlockType::BEDROCK : BlockType::STONE);
+}
+
+Block BlockAccessor::getBlock(int x, int y, int z) {
+    ChunkPos chunkPos = toChunkPos(x, y, z);
+    const Entry& entry = lookup(chunkPos);
+    if (!entry.chunk) return implicitBlock(entry, y);
+    return entry.chunk->getBlock(x - chunkPos.x * CHUNK_SIZE, y - chunkPos.y * CHUNK_HEIGHT, z - chunkPos.z * CHUNK_SIZE);
+}
+
+const std::vector<Block>& BlockAccessor::readRegion(const glm::ivec3& min, const glm::ivec3& max) {
+    glm::ivec3 size = glm::max(max - min + 1, glm::ivec3(0));
+    region.resize(static_cast<size_t>(size.x) * size.y * size.z);
+    if (region.empty()) return region;
+
+    ChunkPos minChunk = toChunkPos(min.x, min.y, min.z);
+    ChunkPos maxChunk = toChunkPos(max.x, max.y, max.z);
+    for (int cy = minChunk.y; cy <= maxChunk.y; ++cy) {
+        for (int cz = minChunk.z; cz <= maxChunk.z; ++cz) {
+            for (int cx = minChunk.x; cx <= maxChunk.x; ++cx) {
+                ChunkPos chunkPos(cx, cy, cz);
+                glm::ivec3 origin(cx * CHUNK_SIZE, cy * CHUNK_HEIGHT, cz * CHUNK_SIZE);
+                // Part of the box inside this chunk, in world coordinates
+                glm::ivec3 from = glm::max(min, origin);
+                glm::ivec3 to = glm::min(max, origin + glm::ivec3(CHUNK_SIZE - 1, CHUNK_HEIGHT - 1, CHUNK_SIZE - 1));
+
+                const Entry& entry = lookup(chunkPos);
+                Block uniform;
+                bool filled = !entry.chunk || entry.chunk->getUniformBlock(uniform);
+                for (int y = from.y; y <= to.y; ++y) {
+                    if (!entry.chunk) uniform = implicitBlock(entry, y);
+                    for (int z = from.z; z <= to.z; ++z) {
+                        Block* row = &region[(static_cast<size_t>(y - min.y) * size.z + (z - min.z)) * size.x];
+                        for (int x = from.x; x <= to.x; ++x) {
+                            row[x - min.x] = filled ? uniform : entry.chunk->getBlock(x - origin.x, y - origin.y, z - origin.z);
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return region;
+}
+
+bool BlockAccessor::anySolid(const glm::ivec3& min, const glm::ivec3& max) {
+    const std::vector<Block>& blocks = readRegion(min, max);
+    return std::any_of(blocks.begin(), blocks.end(), [](const Block& block) { return block.isSolid(); });
+}
+
+void BlockAccessor::setBlock(int x, int y, int z, Block block) {
+    chunkManager.setBlockAt(x, y, z, block);
+    // Loaded chunks stay the same objects; a missing one may have been loaded
+    for (Entry& entry : entries) {
+        if (!entry.chunk) entry.used = false;
+    }
+}
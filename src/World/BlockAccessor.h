@@ -0,0 +1,63 @@
+#pragma once
+
+#include "../Util/Types.h"
+#include "Block.h"
+#include "Chunk.h"
+#include "ChunkManager.h"
+#include "ChunkMap.h"
+#include <array>
+#include <vector>
+#include <glm/glm.hpp>
+
+// Block reads for hot loops (player physics, mob AI, raycasts, fluids); main thread only.
+//
+// World -> chunk coordinates are pure integer math, and the last few chunks looked up
+// are kept as raw pointers, so a run of nearby reads costs one map probe per chunk
+// instead of one per block. The accessor holds a ChunkMap::ReadGuard, which keeps
+// those pointers valid for its lifetime: create one per query / update on the stack,
+// not as a long-lived member. Missing chunks read like getBlockAt (implicit stone,
+// air otherwise).
+class BlockAccessor {
+public:
+    explicit BlockAccessor(ChunkManager& chunkManager);
+
+    BlockAccessor(const BlockAccessor&) = delete;
+    BlockAccessor& operator=(const BlockAccessor&) = delete;
+
+    Block getBlock(int x, int y, int z);
+
+    // Copies the blocks of the box [min, max] (inclusive), x fastest, then z, then y.
+    // Each chunk the box touches is looked up once. The result is reused by the next call.
+    const std::vector<Block>& readRegion(const glm::ivec3& min, const glm::ivec3& max);
+    bool anySolid(const glm::ivec3& min, const glm::ivec3& max);
+
+    // ChunkManager::setBlockAt; may load an implicit chunk, so missing chunks are looked up again
+    void setBlock(int x, int y, int z, Block block);
+
+    static int floorDiv(int value, int divisor) {
+        return (value >= 0 ? value : value - divisor + 1) / divisor;
+    }
+    static ChunkPos toChunkPos(int x, int y, int z) {
+        return ChunkPos(floorDiv(x, CHUNK_SIZE), floorDiv(y, CHUNK_HEIGHT), floorDiv(z, CHUNK_SIZE));
+    }
+
+private:
+    static constexpr int CACHED_CHUNKS = 4;
+
+    struct Entry {
+        ChunkPos pos{0};
+        Chunk* chunk = nullptr;
+        bool solid = false;  // Missing chunk that reads as implicit stone
+        bool used = false;
+    };
+
+    const Entry& lookup(const ChunkPos& pos);
+    static Block implicitBlock(const Entry& entry, int y);
+
+    ChunkManager& chunkManager;
+    ChunkMap::ReadGuard guard;
+    std::array<Entry, CACHED_CHUNKS> entries;
+    int lastEntry = 0;
+    int nextEntry = 0;           // Round-robin replacement
+    std::vector<Block> region;
+};
@@ -1,15 +1,100 @@
 #include "Chunk.h"
+#include "ChunkMap.h"
+#include <bit>
+#include <algorithm>
+
+Chunk::Storage::Storage(int bits)
+    : bits(bits), mask(bits == 0 ? 0 : ((1ull << bits) - 1)) {
+    palette.resize(capacity());
+    if (bits > 0) {
+        wordCount = CHUNK_VOLUME * bits / 64;
+        words = std::make_unique<std::atomic<u64>[]>(wordCount);
+        for (int i = 0; i < wordCount; ++i) {
+            words[i].store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+Block Chunk::Storage::get(int index) const {
+    if (bits == 0) return palette[0];
+
+    int bit = index * bits;
+    u64 word = words[bit >> 6].load(std::memory_order_acquire);
+    u32 value = static_cast<u32>((word >> (bit & 63)) & mask);
+    if (bits == 16) return Block(static_cast<BlockType>(value & 0xFF), static_cast<u8>(value >> 8));
+    return palette[value];
+}
+
+void Chunk::Storage::set(int index, u32 value) {
+    if (bits == 0) return;
+
+    int bit = index * bits;
+    std::atomic<u64>& word = words[bit >> 6];
+    u64 current = word.load(std::memory_order_relaxed);
+    u64 shift = static_cast<u64>(bit & 63);
+    current = (current & ~(mask << shift)) | ((static_cast<u64>(value) & mask) << shift);
+    // Release so a reader that sees the index also sees a newly added palette entry
+    word.store(current, std::memory_order_release);
+}
+
+int Chunk::Storage::findOrAdd(Block block) {
+    if (bits == 16) return static_cast<int>(rawValue(block));
+
+    int size = paletteSize.load(std::memory_order_relaxed);
+    for (int i = 0; i < size; ++i) {
+        if (palette[i] == block) return i;
+    }
+    if (size >= capacity()) return -1;
+
+    palette[size] = block;
+    paletteSize.store(size + 1, std::memory_order_release);
+    return size;
+}
+
+size_t Chunk::Storage::memoryUsage() const {
+    return sizeof(Storage) + palette.capacity() * sizeof(Block) + static_cast<size_t>(wordCount) * sizeof(u64);
+}
+
+int Chunk::bitsForPaletteSize(int size) {
+    if (size <= 1) return 0;
+    if (size <= 2) return 1;
+    if (size <= 4) return 2;
+    if (size <= 16) return 4;
+    if (size <= 256) return 8;
+    return 16;
+}
 
 Chunk::Chunk(const ChunkPos& position)
     : position(position), state(ChunkState::UNLOADED), dirty(false) {
-    blocks.fill(Block(BlockType::AIR));
+    auto initial = std::make_shared<Storage>(0);
+    initial->findOrAdd(Block(BlockType::AIR));
+    storage.store(initial.get(), std::memory_order_release);
+    currentStorage = std::move(initial);
 }
 
+Chunk::~Chunk() = default;
+
 Block Chunk::getBlock(int x, int y, int z) const {
     if (x < 0 || x >= CHUNK_SIZE || y < 0 || y >= CHUNK_HEIGHT || z < 0 || z >= CHUNK_SIZE) {
         return Block(BlockType::AIR);
     }
-    return blocks[getIndex(x, y, z)];
+    ChunkMap::ReadGuard guard;
+    return storage.load(std::memory_order_acquire)->get(getIndex(x, y, z));
+}
+
+bool Chunk::isUniform() const {
+    ChunkMap::ReadGuard guard;
+    return storage.load(std::memory_order_acquire)->bits == 0;
+}
+
+int Chunk::getBitsPerBlock() const {
+    ChunkMap::ReadGuard guard;
+    return storage.load(std::memory_order_acquire)->bits;
+}
+
+int Chunk::getPaletteSize() const {
+    ChunkMap::ReadGuard guard;
+    return storage.load(std::memory_order_acquire)->paletteSize.load(std::memory_order_acquire);
 }
 
 void Chunk::setBlock(int x, int y, int z, Block block) {
@@ -17,16 +102,370 @@ void Chunk::setBlock(int x, int y, int z, Block block) {
         return;
     }
     int idx = getIndex(x, y, z);
-    if (blocks[idx].getType() != block.getType()) {
-        blocks[idx] = block;
+
+    std::lock_guard<std::mutex> lock(writeMutex);
+    Storage* current = storage.load(std::memory_order_relaxed);
+    if (current->get(idx).getType() == block.getType()) {
+        return;
+    }
+
+    if (current->shared) {
+        // Once every snapshot is gone (saved) the storage can be written in place again
+        if (currentStorage.use_count() > 1) {
+            detach();
+            current = storage.load(std::memory_order_relaxed);
+        } else {
+            current->shared = false;
+        }
+    }
+
+    // Storages retired by an earlier write are usually free to go by now
+    if (!retiredStorages.empty()) reclaimStorages(false);
+
+    int value = current->findOrAdd(block);
+    if (value < 0) {
+        promote();
+        current = storage.load(std::memory_order_relaxed);
+        value = current->findOrAdd(block);
+    }
+    current->set(idx, static_cast<u32>(value));
+    dirty = true;
+    modified = true;
+    markMipDirty(x, y, z);
+}
+
+void Chunk::promote() {
+    Storage* current = storage.load(std::memory_order_relaxed);
+    int nextBits = current->bits == 0 ? 1 : current->bits == 8 ? 16 : current->bits * 2;
+
+    auto next = std::make_shared<Storage>(nextBits);
+    if (nextBits == 16) {
+        for (int i = 0; i < CHUNK_VOLUME; ++i) {
+            next->set(i, rawValue(current->get(i)));
+        }
+    } else {
+        // Same palette order, so indices carry over unchanged
+        int size = current->paletteSize.load(std::memory_order_relaxed);
+        for (int i = 0; i < size; ++i) {
+            next->findOrAdd(current->palette[i]);
+        }
+        if (current->bits > 0) {
+            for (int i = 0; i < CHUNK_VOLUME; ++i) {
+                int bit = i * current->bits;
+                u64 word = current->words[bit >> 6].load(std::memory_order_relaxed);
+                next->set(i, static_cast<u32>((word >> (bit & 63)) & current->mask));
+            }
+        }
+    }
+
+    replaceStorage(std::move(next));
+}
+
+void Chunk::detach() {
+    Storage* current = storage.load(std::memory_order_relaxed);
+
+    auto copy = std::make_shared<Storage>(current->bits);
+    int size = current->paletteSize.load(std::memory_order_relaxed);
+    for (int i = 0; i < size; ++i) {
+        copy->findOrAdd(current->palette[i]);
+    }
+    for (int i = 0; i < current->wordCount; ++i) {
+        copy->words[i].store(current->words[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+
+    replaceStorage(std::move(copy));
+}
+
+void Chunk::replaceStorage(std::shared_ptr<Storage> next) {
+    storage.store(next.get(), std::memory_order_release);
+    retiredStorages.push_back(RetiredStorage{ChunkMap::retireEpoch(), std::move(currentStorage)});
+    currentStorage = std::move(next);
+    reclaimStorages(false);
+}
+
+void Chunk::reclaimStorages(bool all) {
+    for (auto it = retiredStorages.begin(); it != retiredStorages.end(); ) {
+        if (!all && !ChunkMap::canReclaim(it->epoch)) {
+            ++it;
+            continue;
+        }
+        // A snapshot still holding it keeps it alive on its own
+        if (it->storage.use_count() == 1) addSpare(std::move(it->storage));
+        it = retiredStorages.erase(it);
+    }
+}
+
+void Chunk::addSpare(std::shared_ptr<Storage> spare) {
+    for (const auto& s : spareStorages) {
+        if (s->bits == spare->bits) return;
+    }
+    spareStorages.push_back(std::move(spare));
+}
+
+Chunk::Snapshot Chunk::snapshot() const {
+    std::lock_guard<std::mutex> lock(writeMutex);
+    currentStorage->shared = true;
+
+    Snapshot result;
+    result.storage = currentStorage;
+    return result;
+}
+
+void Chunk::Snapshot::copyBlocks(Block* out) const {
+    if (storage->bits == 0) {
+        std::fill(out, out + CHUNK_VOLUME, storage->palette[0]);
+        return;
+    }
+    for (int i = 0; i < CHUNK_VOLUME; ++i) {
+        out[i] = storage->get(i);
+    }
+}
+
+void Chunk::copyBlocks(Block* out) const {
+    ChunkMap::ReadGuard guard;
+    const Storage* current = storage.load(std::memory_order_acquire);
+    if (current->bits == 0) {
+        std::fill(out, out + CHUNK_VOLUME, current->palette[0]);
+        return;
+    }
+    for (int i = 0; i < CHUNK_VOLUME; ++i) {
+        out[i] = current->get(i);
+    }
+}
+
+void Chunk::setBlocks(const Block* blocks) {
+    // Build the palette first so the storage is created at its final width
+    std::vector<Block> palette;
+    std::vector<u16> indices(CHUNK_VOLUME);
+    int last = -1;
+    for (int i = 0; i < CHUNK_VOLUME; ++i) {
+        if (last >= 0 && palette[last] == blocks[i]) {
+            indices[i] = static_cast<u16>(last);
+            continue;
+        }
+        last = -1;
+        for (size_t p = 0; p < palette.size(); ++p) {
+            if (palette[p] == blocks[i]) {
+                last = static_cast<int>(p);
+                break;
+            }
+        }
+        if (last < 0) {
+            last = static_cast<int>(palette.size());
+            palette.push_back(blocks[i]);
+        }
+        indices[i] = static_cast<u16>(last);
+    }
+
+    std::shared_ptr<Storage> next;
+    {
+        std::lock_guard<std::mutex> lock(writeMutex);
+        next = takeStorage(bitsForPaletteSize(static_cast<int>(palette.size())));
+    }
+    // Every index is written below, so a reused storage needs no clearing
+    if (next->bits == 16) {
+        for (int i = 0; i < CHUNK_VOLUME; ++i) next->set(i, rawValue(blocks[i]));
+    } else {
+        for (const Block& b : palette) next->findOrAdd(b);
+        for (int i = 0; i < CHUNK_VOLUME; ++i) next->set(i, indices[i]);
+    }
+
+    std::lock_guard<std::mutex> lock(writeMutex);
+    // Same dirty/modified rule as setBlock: only a block type change counts
+    const Storage* current = storage.load(std::memory_order_relaxed);
+    bool changed = false;
+    for (int i = 0; i < CHUNK_VOLUME && !changed; ++i) {
+        changed = current->get(i).getType() != blocks[i].getType();
+    }
+
+    replaceStorage(std::move(next));
+    if (changed) {
         dirty = true;
         modified = true;
     }
+    markMipDirtyAll();
+}
+
+size_t Chunk::getMemoryUsage() const {
+    size_t total = 0;
+    {
+        std::lock_guard<std::mutex> lock(writeMutex);
+        total += currentStorage->memoryUsage();
+        for (const auto& retired : retiredStorages) {
+            total += retired.storage->memoryUsage();
+        }
+        for (const auto& s : spareStorages) {
+            total += s->memoryUsage();
+        }
+    }
+    std::lock_guard<std::mutex> lock(mipMutex);
+    for (int level = 1; level <= CHUNK_MIP_LEVELS; ++level) {
+        if (!mipCells[level - 1]) continue;
+        size_t size = static_cast<size_t>(mipSize(level));
+        total += size * size * size * sizeof(MipCell);
+    }
+    return total;
+}
+
+size_t Chunk::Snapshot::getMemoryUsage() const {
+    return storage ? storage->memoryUsage() : 0;
+}
+
+std::shared_ptr<Chunk::Storage> Chunk::takeStorage(int bits) {
+    for (auto it = spareStorages.begin(); it != spareStorages.end(); ++it) {
+        if ((*it)->bits != bits) continue;
+        std::shared_ptr<Storage> reused = std::move(*it);
+        spareStorages.erase(it);
+        reused->paletteSize.store(0, std::memory_order_relaxed);
+        reused->shared = false;
+        return reused;
+    }
+    return std::make_shared<Storage>(bits);
+}
+
+void Chunk::reset(const ChunkPos& newPosition) {
+    std::lock_guard<std::mutex> lock(writeMutex);
+    // Nothing references the chunk any more, so no reader can either. Storages still
+    // held by a snapshot (a save in flight) stay with it.
+    reclaimStorages(true);
+    if (currentStorage.use_count() == 1) addSpare(std::move(currentStorage));
+    currentStorage.reset();
+
+    // All air without touching a block: a single-value storage
+    std::shared_ptr<Storage> empty = takeStorage(0);
+    empty->findOrAdd(Block(BlockType::AIR));
+    storage.store(empty.get(), std::memory_order_release);
+    currentStorage = std::move(empty);
+
+    position = newPosition;
+    state.store(ChunkState::UNLOADED);
+    dirty = false;
+    modified = false;
+    edited.store(false, std::memory_order_relaxed);
+    currentLOD.store(0, std::memory_order_relaxed);
+    setMeshSizeHint({});
+    meshedNeighbors = 0;
+    // Mip arrays stay allocated, their contents are stale
+    markMipDirtyAll();
 }
 
 bool Chunk::isBlockOpaque(int x, int y, int z) const {
     if (x < 0 || x >= CHUNK_SIZE || y < 0 || y >= CHUNK_HEIGHT || z < 0 || z >= CHUNK_SIZE) {
         return false;
     }
-    return blocks[getIndex(x, y, z)].isOpaque();
+    return getBlock(x, y, z).isOpaque();
+}
+
+bool Chunk::isLayerOpaque(int axis, int layer) const {
+    ChunkMap::ReadGuard guard;
+    const Storage* current = storage.load(std::memory_order_acquire);
+    if (current->bits == 0) return current->palette[0].isOpaque();
+
+    for (int a = 0; a < CHUNK_SIZE; ++a) {
+        for (int b = 0; b < CHUNK_SIZE; ++b) {
+            int x = axis == 0 ? layer : a;
+            int y = axis == 1 ? layer : (axis == 0 ? a : b);
+            int z = axis == 2 ? layer : b;
+            if (!current->get(getIndex(x, y, z)).isOpaque()) return false;
+        }
+    }
+    return true;
+}
+
+bool Chunk::getUniformBlock(Block& out) const {
+    ChunkMap::ReadGuard guard;
+    const Storage* current = storage.load(std::memory_order_acquire);
+    if (current->bits != 0) return false;
+    out = current->palette[0];
+    return true;
+}
+
+void Chunk::markMipDirty(int x, int y, int z) {
+    for (int level = 1; level <= CHUNK_MIP_LEVELS; ++level) {
+        int size = mipSize(level);
+        int cell = ((y >> level) * size + (z >> level)) * size + (x >> level);
+        mipDirty[mipDirtyWordOffset(level) + cell / 64].fetch_or(1ull << (cell % 64), std::memory_order_release);
+    }
+}
+
+void Chunk::markMipDirtyAll() {
+    for (auto& word : mipDirty) word.store(~0ull, std::memory_order_release);
+}
+
+Chunk::MipCell Chunk::computeMipCell(const Storage& source, int level, int cx, int cy, int cz) {
+    // Distinct visible blocks of the cube and their counts
+    std::array<std::pair<Block, int>, 64> counts;
+    int distinct = 0;
+    int visible = 0;
+    int opaque = 0;
+    int extent = 1 << level;
+    for (int y = cy * extent; y < (cy + 1) * extent; ++y) {
+        for (int z = cz * extent; z < (cz + 1) * extent; ++z) {
+            for (int x = cx * extent; x < (cx + 1) * extent; ++x) {
+                Block block = source.get(getIndex(x, y, z));
+                // Plants vanish at a distance: they're never meshed above LOD 0
+                if (block.getType() == BlockType::AIR || block.isCrossModel()) continue;
+                visible++;
+                if (block.isOpaque()) opaque++;
+
+                int i = 0;
+                while (i < distinct && !(counts[i].first == block)) ++i;
+                if (i == distinct && distinct < static_cast<int>(counts.size())) counts[distinct++] = {block, 0};
+                if (i < distinct) counts[i].second++;
+            }
+        }
+    }
+
+    MipCell cell;
+    cell.block = Block(BlockType::AIR);
+    cell.opaque = static_cast<u8>(opaque);
+    if (visible * 2 < mipCellVolume(level)) return cell;
+
+    // Most common, opaque first on ties so surfaces don't thin out
+    int best = -1;
+    for (int i = 0; i < distinct; ++i) {
+        if (best < 0 || counts[i].second > counts[best].second ||
+            (counts[i].second == counts[best].second && counts[i].first.isOpaque() && !counts[best].first.isOpaque())) {
+            best = i;
+        }
+    }
+    cell.block = counts[best].first;
+    return cell;
+}
+
+void Chunk::copyMipLevel(int level, MipCell* out) const {
+    int size = mipSize(level);
+    int count = size * size * size;
+
+    // One consistent storage for every cell computed below
+    ChunkMap::ReadGuard guard;
+    const Storage* current = storage.load(std::memory_order_acquire);
+    if (current->bits == 0) {
+        // Uniform: every cell is the whole-cube answer, nothing to cache
+        MipCell cell = computeMipCell(*current, level, 0, 0, 0);
+        std::fill(out, out + count, cell);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mipMutex);
+    auto& cells = mipCells[level - 1];
+    int words = std::max(1, count / 64);
+    std::atomic<u64>* dirty = &mipDirty[mipDirtyWordOffset(level)];
+    if (!cells) {
+        cells = std::make_unique<MipCell[]>(count);
+        for (int w = 0; w < words; ++w) dirty[w].store(~0ull, std::memory_order_relaxed);
+    }
+
+    // Clear each flag before reading the blocks, so a write racing with this re-flags its cell
+    for (int w = 0; w < words; ++w) {
+        u64 bits = dirty[w].exchange(0, std::memory_order_acq_rel);
+        if (count < 64) bits &= (1ull << count) - 1;
+        if (bits) current = storage.load(std::memory_order_acquire);
+        while (bits) {
+            int cell = w * 64 + std::countr_zero(bits);
+            bits &= bits - 1;
+            cells[cell] = computeMipCell(*current, level, cell % size, cell / (size * size), (cell / size) % size);
+        }
+    }
+    std::copy(cells.get(), cells.get() + count, out);
 }
@@ -3,9 +3,12 @@
 #include "../Util/Types.h"
 #include "../Util/Config.h"
 #include "Block.h"
+#include <algorithm>
 #include <array>
 #include <memory>
 #include <atomic>
+#include <mutex>
+#include <vector>
 
 enum class ChunkState {
     UNLOADED,
@@ -15,12 +18,43 @@ enum class ChunkState {
     GPU_UPLOADED
 };
 
-class Chunk {
+// Mip dirty-bit words before level 'level': one bit per cell, at least one word per level
+constexpr int mipDirtyWordOffset(int level) {
+    int offset = 0;
+    for (int l = 1; l < level; ++l) {
+        int size = CHUNK_SIZE >> l;
+        offset += std::max(1, size * size * size / 64);
+    }
+    return offset;
+}
+
+// Names one use of a pooled chunk: its ChunkPool slot and that slot's acquire count
+// (0 = not from a pool). A recycled chunk gets a new handle.
+struct ChunkHandle {
+    u32 slot = 0;
+    u32 generation = 0;
+
+    bool operator==(const ChunkHandle& other) const { return slot == other.slot && generation == other.generation; }
+    bool operator!=(const ChunkHandle& other) const { return !(*this == other); }
+};
+
+// Block storage is paletted: a chunk holds a small palette of distinct blocks and
+// packs per-block palette indices at 1, 2, 4 or 8 bits. Uniform chunks (all air,
+// all stone) store a single value and no index array at all. Chunks with more than
+// 256 distinct blocks fall back to 16-bit raw blocks. Writes promote the storage
+// transparently when the palette outgrows the current index width.
+class Chunk : public std::enable_shared_from_this<Chunk> {
+    struct Storage;
+
 public:
     Chunk(const ChunkPos& position);
-    ~Chunk() = default;
+    ~Chunk();
+
+    Chunk(const Chunk&) = delete;
+    Chunk& operator=(const Chunk&) = delete;
 
     const ChunkPos& getPosition() const { return position; }
+    const ChunkHandle& getHandle() const { return handle; }
     ChunkState getState() const { return state.load(); }
     void setState(ChunkState newState) { state.store(newState); }
 
@@ -28,28 +62,161 @@ public:
     void setBlock(int x, int y, int z, Block block);
     
     bool isBlockOpaque(int x, int y, int z) const;
+    bool isLayerOpaque(int axis, int layer) const; // Every block with coord[axis] == layer is opaque
+
+    // True while every block is the same (set by generation / setBlocks, cleared by the
+    // first differing setBlock). Meshing, fluid scanning and rendering skip these chunks.
+    bool isUniform() const;
+    bool getUniformBlock(Block& out) const; // Fills 'out' and returns true if uniform (single snapshot)
     
-    const std::array<Block, CHUNK_VOLUME>& getBlocks() const { return blocks; }
-    std::array<Block, CHUNK_VOLUME>& getBlocks() { return blocks; }
+    // Bulk access in the dense index order (y * CHUNK_AREA + z * CHUNK_SIZE + x)
+    void copyBlocks(Block* out) const;
+    void setBlocks(const Block* blocks); // Repacks with the smallest palette that fits
 
     bool isDirty() const { return dirty; }
     void setDirty(bool value) { dirty = value; }
 
+    // Edited since it was last saved (set by block changes, cleared when a save snapshots it)
     bool isModified() const { return modified; }
     void setModified(bool value) { modified = value; }
 
-    int getCurrentLOD() const { return currentLOD; }
-    void setCurrentLOD(int lod) { currentLOD = lod; }
+    // Edited since its last LOD 0 mesh (set by ChunkManager::setBlockAt); only these
+    // chunks keep a cached mesh for incremental re-meshing
+    void markEdited() { edited.store(true, std::memory_order_relaxed); }
+    bool takeEdited() { return edited.exchange(false, std::memory_order_relaxed); }
+
+    int getCurrentLOD() const { return currentLOD.load(std::memory_order_relaxed); }
+    void setCurrentLOD(int lod) { currentLOD.store(lod, std::memory_order_relaxed); }
+
+    // Downsampled blocks for LOD meshing. Level n (1..CHUNK_MIP_LEVELS) has one cell per
+    // 2^n block cube: its most common visible block (air when less than half the cube is
+    // filled) and how many of its blocks are opaque. Built on first use, then refreshed
+    // lazily: writes only flag the cells they touch.
+    struct MipCell {
+        Block block;
+        u8 opaque = 0;
+    };
+    static constexpr int mipSize(int level) { return CHUNK_SIZE >> level; }
+    static constexpr int mipCellVolume(int level) { return 1 << (3 * level); }
+    // mipSize(level)^3 cells, indexed (y * size + z) * size + x
+    void copyMipLevel(int level, MipCell* out) const;
+
+    // Neighbors (all 26) that had finished generating when the current mesh was scheduled
+    // (bit order of ChunkManager's neighbor table); main thread only
+    u32 getMeshedNeighbors() const { return meshedNeighbors; }
+    void setMeshedNeighbors(u32 mask) { meshedNeighbors = mask; }
+
+    // Buffer sizes of the last mesh built for this chunk; the next rebuild reserves them up front
+    struct MeshSizeHint {
+        u32 vertices = 0;
+        u32 waterVertices = 0;
+    };
+    MeshSizeHint getMeshSizeHint() const {
+        return {meshSizeHint[0].load(std::memory_order_relaxed), meshSizeHint[1].load(std::memory_order_relaxed)};
+    }
+    void setMeshSizeHint(const MeshSizeHint& hint) {
+        meshSizeHint[0].store(hint.vertices, std::memory_order_relaxed);
+        meshSizeHint[1].store(hint.waterVertices, std::memory_order_relaxed);
+    }
+
+    // Immutable view of the blocks at one point in time, safe to read from any thread
+    // and after the chunk is gone. Taking one is O(1): the next write to the chunk
+    // copies the storage instead of changing it in place.
+    class Snapshot {
+    public:
+        Snapshot() = default;
+        bool isValid() const { return storage != nullptr; }
+        void copyBlocks(Block* out) const;
+        bool operator==(const Snapshot& other) const { return storage == other.storage; }
+        size_t getMemoryUsage() const;
+
+    private:
+        friend class Chunk;
+        std::shared_ptr<const Storage> storage;
+    };
+    Snapshot snapshot() const;
+
+    // Storage stats
+    int getBitsPerBlock() const;
+    int getPaletteSize() const;
+    size_t getMemoryUsage() const; // Block storages (including retired and spare ones) and mip arrays
 
 private:
+    friend class ChunkPool;
+    struct Storage {
+        int bits;                              // 0 = single value, 1/2/4/8 = palette index, 16 = raw blocks
+        u64 mask;
+        std::atomic<int> paletteSize{0};
+        std::vector<Block> palette;            // Sized to capacity up front, never reallocated
+        std::unique_ptr<std::atomic<u64>[]> words;
+        int wordCount = 0;
+        bool shared = false;                   // Held by a Snapshot: copy before writing (writer mutex)
+
+        explicit Storage(int bits);
+        int capacity() const { return bits == 0 ? 1 : bits == 16 ? 0 : (1 << bits); }
+        Block get(int index) const;
+        void set(int index, u32 value);
+        int findOrAdd(Block block); // -1 when the palette is full
+        size_t memoryUsage() const;
+    };
+
+    static int bitsForPaletteSize(int size);
+    static u32 rawValue(Block block) { return static_cast<u32>(block.type) | (static_cast<u32>(block.data) << 8); }
+    void promote(); // Writer mutex must be held
+    void detach();  // Writer mutex must be held; replaces a snapshotted storage with a private copy
+    // Writer mutex must be held; a spare storage of that width (indices undefined) or a new one
+    std::shared_ptr<Storage> takeStorage(int bits);
+    // Writer mutex must be held; publishes 'next' and retires the current storage
+    void replaceStorage(std::shared_ptr<Storage> next);
+    // Writer mutex must be held; drops retired storages no reader can still be using,
+    // keeping the ones no snapshot holds as spares
+    void reclaimStorages(bool all);
+    void addSpare(std::shared_ptr<Storage> spare);
+
+    // ChunkPool reuse once nothing references the chunk: an all-air UNLOADED chunk at
+    // 'newPosition'. Storages no snapshot holds are kept as spares for setBlocks.
+    void reset(const ChunkPos& newPosition);
+
     ChunkPos position;
-    std::array<Block, CHUNK_VOLUME> blocks;
+
+    // Readers load the current storage lock-free under a ChunkMap::ReadGuard (the
+    // accessors take one). A replaced storage is retired with the guard's epoch and
+    // only reused or released once no reader that could have loaded it is left; a
+    // snapshot keeps its own reference.
+    struct RetiredStorage {
+        u64 epoch;
+        std::shared_ptr<Storage> storage;
+    };
+    std::atomic<Storage*> storage;
+    std::shared_ptr<Storage> currentStorage;
+    std::vector<RetiredStorage> retiredStorages;
+    std::vector<std::shared_ptr<Storage>> spareStorages; // At most one per width
+    mutable std::mutex writeMutex;
+    ChunkHandle handle;
+
     std::atomic<ChunkState> state;
     bool dirty;
-    bool modified = false;
-    int currentLOD = 0;
+    std::atomic<bool> modified{false};
+    std::atomic<bool> edited{false};
+    std::atomic<int> currentLOD{0};
+    std::atomic<u32> meshSizeHint[2] = {};
+    u32 meshedNeighbors = 0;
+
+    static MipCell computeMipCell(const Storage& storage, int level, int cx, int cy, int cz);
+    void markMipDirty(int x, int y, int z);
+    void markMipDirtyAll();
+
+    // Allocated by the first copyMipLevel of each level; writers only set dirty bits
+    mutable std::mutex mipMutex;
+    mutable std::unique_ptr<MipCell[]> mipCells[CHUNK_MIP_LEVELS];
+    mutable std::atomic<u64> mipDirty[mipDirtyWordOffset(CHUNK_MIP_LEVELS + 1)] = {};
 
     static int getIndex(int x, int y, int z) {
         return y * CHUNK_AREA + z * CHUNK_SIZE + x;
     }
 };
+
+// A chunk and its 26 neighbors, indexed (dy + 1) * 9 + (dz + 1) * 3 + (dx + 1);
+// the chunk itself is at NEIGHBORHOOD_CENTER, missing neighbors are null
+using ChunkNeighborhood = std::array<std::shared_ptr<Chunk>, 27>;
+constexpr int NEIGHBORHOOD_CENTER = 13;
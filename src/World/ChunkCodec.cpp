@@ -0,0 +1,247 @@
+#include "ChunkCodec.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+void putVarint(std::vector<u8>& out, u32 value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<u8>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<u8>(value));
+}
+
+bool getVarint(const u8*& p, const u8* end, u32& value) {
+    value = 0;
+    for (int shift = 0; shift < 32; shift += 7) {
+        if (p == end) return false;
+        u8 byte = *p++;
+        value |= static_cast<u32>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+// LZ4-style lengths: a 4-bit nibble, 15 = more bytes follow (255 = keep going)
+void putLength(std::vector<u8>& out, size_t length) {
+    if (length < 15) return;
+    length -= 15;
+    while (length >= 255) {
+        out.push_back(255);
+        length -= 255;
+    }
+    out.push_back(static_cast<u8>(length));
+}
+
+bool getLength(const u8*& p, const u8* end, size_t& length) {
+    if (length < 15) return true;
+    u8 byte;
+    do {
+        if (p == end) return false;
+        byte = *p++;
+        length += byte;
+    } while (byte == 255);
+    return true;
+}
+
+constexpr size_t LZ_MIN_MATCH = 4;
+constexpr size_t LZ_MAX_OFFSET = 65535;
+constexpr int LZ_HASH_BITS = 12;
+
+u32 lzHash(const u8* p) {
+    u32 v;
+    std::memcpy(&v, p, sizeof(u32));
+    return (v * 2654435761u) >> (32 - LZ_HASH_BITS);
+}
+
+// Upper bound for a decoded v2 body (palette + one run per block)
+constexpr size_t MAX_BODY_SIZE = 5 + CHUNK_VOLUME * 2 + CHUNK_VOLUME * 6;
+}
+
+void ChunkCodec::lzCompress(const u8* in, size_t size, std::vector<u8>& out) {
+    out.clear();
+    out.reserve(size + size / 255 + 16);
+
+    std::vector<i32> table(1 << LZ_HASH_BITS, -1);
+    size_t anchor = 0; // First literal not emitted yet
+    size_t pos = 0;
+
+    auto emit = [&](size_t literalEnd, size_t matchOffset, size_t matchLength) {
+        size_t literals = literalEnd - anchor;
+        size_t matchCode = matchLength ? matchLength - LZ_MIN_MATCH : 0;
+        out.push_back(static_cast<u8>((std::min<size_t>(literals, 15) << 4) | std::min<size_t>(matchCode, 15)));
+        putLength(out, literals);
+        out.insert(out.end(), in + anchor, in + literalEnd);
+        if (matchLength) {
+            out.push_back(static_cast<u8>(matchOffset & 0xFF));
+            out.push_back(static_cast<u8>(matchOffset >> 8));
+            putLength(out, matchCode);
+        }
+    };
+
+    while (size >= LZ_MIN_MATCH && pos + LZ_MIN_MATCH <= size) {
+        u32 h = lzHash(in + pos);
+        i32 candidate = table[h];
+        table[h] = static_cast<i32>(pos);
+
+        if (candidate >= 0 && pos - candidate <= LZ_MAX_OFFSET &&
+            std::memcmp(in + candidate, in + pos, LZ_MIN_MATCH) == 0) {
+            size_t length = LZ_MIN_MATCH;
+            while (pos + length < size && in[candidate + length] == in[pos + length]) {
+                ++length;
+            }
+            emit(pos, pos - candidate, length);
+            pos += length;
+            anchor = pos;
+        } else {
+            ++pos;
+        }
+    }
+
+    // Final sequence is literals only; the decoder stops when the input runs out after it
+    emit(size, 0, 0);
+}
+
+bool ChunkCodec::lzDecompress(const u8* in, size_t size, u8* out, size_t outSize) {
+    const u8* p = in;
+    const u8* end = in + size;
+    size_t op = 0;
+
+    while (p < end) {
+        u8 token = *p++;
+
+        size_t literals = token >> 4;
+        if (!getLength(p, end, literals)) return false;
+        if (literals > static_cast<size_t>(end - p) || literals > outSize - op) return false;
+        std::memcpy(out + op, p, literals);
+        p += literals;
+        op += literals;
+
+        if (p == end) break;
+
+        if (end - p < 2) return false;
+        size_t offset = p[0] | (static_cast<size_t>(p[1]) << 8);
+        p += 2;
+        size_t length = token & 0x0F;
+        if (!getLength(p, end, length)) return false;
+        length += LZ_MIN_MATCH;
+        if (offset == 0 || offset > op || length > outSize - op) return false;
+
+        // Byte by byte: matches may overlap their own output
+        for (size_t i = 0; i < length; ++i, ++op) {
+            out[op] = out[op - offset];
+        }
+    }
+    return op == outSize;
+}
+
+void ChunkCodec::encode(const Block* blocks, std::vector<u8>& out, bool compress) {
+    // Palette in order of first appearance
+    std::vector<Block> palette;
+    std::vector<u16> indices(CHUNK_VOLUME);
+    int last = -1;
+    for (int i = 0; i < CHUNK_VOLUME; ++i) {
+        if (last >= 0 && palette[last] == blocks[i]) {
+            indices[i] = static_cast<u16>(last);
+            continue;
+        }
+        last = -1;
+        for (size_t p = 0; p < palette.size(); ++p) {
+            if (palette[p] == blocks[i]) {
+                last = static_cast<int>(p);
+                break;
+            }
+        }
+        if (last < 0) {
+            last = static_cast<int>(palette.size());
+            palette.push_back(blocks[i]);
+        }
+        indices[i] = static_cast<u16>(last);
+    }
+
+    std::vector<u8> body;
+    body.reserve(64);
+    putVarint(body, static_cast<u32>(palette.size()));
+    for (const Block& block : palette) {
+        body.push_back(static_cast<u8>(block.type));
+        body.push_back(block.data);
+    }
+    for (int i = 0; i < CHUNK_VOLUME;) {
+        int run = 1;
+        while (i + run < CHUNK_VOLUME && indices[i + run] == indices[i]) ++run;
+        putVarint(body, static_cast<u32>(run));
+        putVarint(body, indices[i]);
+        i += run;
+    }
+
+    out.clear();
+    out.push_back(TAG);
+    out.push_back(VERSION);
+    out.push_back(0);
+    out.push_back(0);
+
+    if (compress) {
+        std::vector<u8> packed;
+        lzCompress(body.data(), body.size(), packed);
+        if (packed.size() + sizeof(u32) < body.size()) {
+            out[2] |= FLAG_LZ;
+            u32 bodySize = static_cast<u32>(body.size());
+            const u8* sizeBytes = reinterpret_cast<const u8*>(&bodySize);
+            out.insert(out.end(), sizeBytes, sizeBytes + sizeof(u32));
+            out.insert(out.end(), packed.begin(), packed.end());
+            return;
+        }
+    }
+    out.insert(out.end(), body.begin(), body.end());
+}
+
+int ChunkCodec::getVersion(const std::vector<u8>& data) {
+    if (data.size() >= HEADER_SIZE && data[0] == TAG) return data[1];
+    if (data.size() == CHUNK_VOLUME * sizeof(Block)) return 1;
+    return 0;
+}
+
+bool ChunkCodec::decode(const std::vector<u8>& data, Block* blocks) {
+    int version = getVersion(data);
+    if (version == 1) {
+        std::memcpy(blocks, data.data(), data.size());
+        return true;
+    }
+    if (version != VERSION) return false;
+
+    const u8* p = data.data() + HEADER_SIZE;
+    const u8* end = data.data() + data.size();
+
+    std::vector<u8> unpacked;
+    if (data[2] & FLAG_LZ) {
+        if (end - p < static_cast<std::ptrdiff_t>(sizeof(u32))) return false;
+        u32 bodySize;
+        std::memcpy(&bodySize, p, sizeof(u32));
+        p += sizeof(u32);
+        if (bodySize > MAX_BODY_SIZE) return false;
+        unpacked.resize(bodySize);
+        if (!lzDecompress(p, static_cast<size_t>(end - p), unpacked.data(), bodySize)) return false;
+        p = unpacked.data();
+        end = p + unpacked.size();
+    }
+
+    u32 paletteSize;
+    if (!getVarint(p, end, paletteSize)) return false;
+    if (paletteSize == 0 || paletteSize > CHUNK_VOLUME || static_cast<size_t>(end - p) < paletteSize * 2) return false;
+    std::vector<Block> palette(paletteSize);
+    for (u32 i = 0; i < paletteSize; ++i) {
+        palette[i] = Block(static_cast<BlockType>(p[0]), p[1]);
+        p += 2;
+    }
+
+    int filled = 0;
+    while (filled < CHUNK_VOLUME) {
+        u32 run;
+        u32 index;
+        if (!getVarint(p, end, run) || !getVarint(p, end, index)) return false;
+        if (run == 0 || run > static_cast<u32>(CHUNK_VOLUME - filled) || index >= paletteSize) return false;
+        std::fill(blocks + filled, blocks + filled + run, palette[index]);
+        filled += static_cast<int>(run);
+    }
+    return p == end;
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "../Util/Types.h"
+#include "../Util/Config.h"
+#include "Block.h"
+#include <vector>
+
+// Chunk payload format used by region files.
+//
+// Version 1 (legacy): CHUNK_VOLUME raw Blocks, no header.
+// Version 2: 4-byte header { 'C', version, flags, 0 } followed by the body:
+//   varint paletteSize, paletteSize x { u8 type, u8 data }
+//   runs along the dense index order (y-major): { varint length, varint paletteIndex }
+// With FLAG_LZ the body is stored as u32 bodySize + an LZ77 block (LZ4-style
+// token stream) and only kept when it is actually smaller.
+// A version 1 payload can't be mistaken for a newer one: its first byte is a
+// BlockType, which never reaches 'C'.
+class ChunkCodec {
+public:
+    static constexpr u8 VERSION = 2;
+
+    static void encode(const Block* blocks, std::vector<u8>& out, bool compress = true);
+    static bool decode(const std::vector<u8>& data, Block* blocks); // blocks holds CHUNK_VOLUME; false if corrupt
+    static int getVersion(const std::vector<u8>& data);             // 0 if unrecognized
+
+    // General-purpose byte compressor used for FLAG_LZ
+    static void lzCompress(const u8* in, size_t size, std::vector<u8>& out);
+    static bool lzDecompress(const u8* in, size_t size, u8* out, size_t outSize);
+
+private:
+    static constexpr u8 TAG = 'C';
+    static constexpr u8 FLAG_LZ = 1;
+    static constexpr size_t HEADER_SIZE = 4;
+};
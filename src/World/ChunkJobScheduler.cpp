@@ -0,0 +1,130 @@
+#include "ChunkJobScheduler.h"
+#include "../Core/ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+
+ChunkJobScheduler::ChunkJobScheduler(size_t maxInFlight) {
+    if (maxInFlight == 0) maxInFlight = 1;
+    slots.resize(maxInFlight);
+    for (size_t i = maxInFlight; i-- > 0;) {
+        freeSlots.push_back(i);
+    }
+}
+
+void ChunkJobScheduler::setView(const glm::vec3& pos, const glm::vec3& dir, int r) {
+    cameraPos = pos;
+    float len = glm::length(dir);
+    if (len > 1e-4f) viewDir = dir / len;
+
+    centerX.store(static_cast<int>(std::floor(pos.x / CHUNK_SIZE)));
+    centerZ.store(static_cast<int>(std::floor(pos.z / CHUNK_SIZE)));
+    range.store(r);
+}
+
+bool ChunkJobScheduler::isInRange(const ChunkPos& pos) const {
+    // Same metric as ChunkManager::isChunkInRange / unloadDistantChunks
+    int dx = pos.x - centerX.load();
+    int dz = pos.z - centerZ.load();
+    int r = range.load();
+    return (dx * dx + dz * dz) <= (r * r);
+}
+
+float ChunkJobScheduler::computePriority(const ChunkPos& pos) const {
+    glm::vec3 center(
+        pos.x * CHUNK_SIZE + CHUNK_SIZE * 0.5f,
+        pos.y * CHUNK_HEIGHT + CHUNK_HEIGHT * 0.5f,
+        pos.z * CHUNK_SIZE + CHUNK_SIZE * 0.5f
+    );
+    glm::vec3 toChunk = center - cameraPos;
+    float dist = glm::length(toChunk);
+    if (dist < 1e-4f) return 0.0f;
+
+    // Chunks behind the camera count as up to twice as far away
+    float facing = glm::dot(toChunk / dist, viewDir);
+    return dist * (1.0f + (1.0f - facing) * 0.5f);
+}
+
+void ChunkJobScheduler::cancel(ChunkJob& job) {
+    // Hand the chunk back to the state that makes ChunkManager request it again
+    if (job.type == ChunkJobType::GENERATE) {
+        if (job.chunk->getState() == ChunkState::GENERATING) job.chunk->setState(ChunkState::UNLOADED);
+    } else {
+        if (job.chunk->getState() == ChunkState::READY) job.chunk->setState(ChunkState::MESH_BUILD);
+    }
+    dropped++;
+}
+
+void ChunkJobScheduler::dispatch(ThreadPool& pool) {
+    if (pending.empty()) return;
+
+    // 1. Drop jobs whose chunk left range, re-score the rest
+    size_t kept = 0;
+    for (size_t i = 0; i < pending.size(); ++i) {
+        ChunkJob& job = pending[i];
+        if (!isInRange(job.chunk->getPosition())) {
+            cancel(job);
+            continue;
+        }
+        job.priority = computePriority(job.chunk->getPosition());
+        if (kept != i) pending[kept] = std::move(job);
+        kept++;
+    }
+    pending.resize(kept);
+
+    // 2. Submit the best jobs into free slots
+    size_t available;
+    {
+        std::lock_guard<std::mutex> lock(slotMutex);
+        available = std::min(freeSlots.size(), pending.size());
+    }
+    if (available == 0) return;
+
+    auto byPriority = [](const ChunkJob& a, const ChunkJob& b) { return a.priority < b.priority; };
+    std::partial_sort(pending.begin(), pending.begin() + available, pending.end(), byPriority);
+
+    for (size_t i = 0; i < available; ++i) {
+        size_t slot;
+        {
+            std::lock_guard<std::mutex> lock(slotMutex);
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+        }
+        JobPriority priority = pending[i].type == ChunkJobType::MESH ? JobPriority::HIGH : JobPriority::NORMAL;
+        slots[slot] = std::move(pending[i]);
+        inFlight++;
+        pool.submit([this, slot]() { run(slot); }, priority);
+    }
+    pending.erase(pending.begin(), pending.begin() + available);
+}
+
+void ChunkJobScheduler::run(size_t slot) {
+    ChunkJob job = std::move(slots[slot]);
+    {
+        std::lock_guard<std::mutex> lock(slotMutex);
+        freeSlots.push_back(slot);
+    }
+
+    // Counts the job as finished even if it throws (the pool logs and swallows the exception)
+    struct InFlightGuard {
+        std::atomic<size_t>& count;
+        ~InFlightGuard() { count--; }
+    } guard{inFlight};
+
+    // The player may have moved away since the job was dispatched
+    if (isInRange(job.chunk->getPosition())) {
+        try {
+            job.work();
+        } catch (...) {
+            // Requested again instead of being stuck in GENERATING / READY
+            failed++;
+            cancel(job);
+            throw;
+        }
+    } else {
+        cancel(job);
+    }
+}
+
+void ChunkJobScheduler::clear() {
+    pending.clear();
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "../Util/Types.h"
+#include "../Util/Config.h"
+#include "../Core/Job.h"
+#include "Chunk.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class ThreadPool;
+
+enum class ChunkJobType {
+    GENERATE,
+    MESH
+};
+
+// Holds chunk generation/mesh jobs back from the ThreadPool so they can be
+// re-prioritized every frame (distance + view direction) and dropped once their
+// chunk leaves range. Only a small number of jobs is in flight at a time; jobs
+// are re-checked right before they start running.
+class ChunkJobScheduler {
+public:
+    explicit ChunkJobScheduler(size_t maxInFlight = MAX_CHUNK_JOBS_IN_FLIGHT);
+    ~ChunkJobScheduler() = default;
+
+    // Camera state used for ordering and cancellation; range is in chunks (horizontal)
+    void setView(const glm::vec3& cameraPos, const glm::vec3& viewDir, int range);
+
+    template<typename F>
+    void schedule(std::shared_ptr<Chunk> chunk, ChunkJobType type, F&& work) {
+        pending.push_back({std::move(chunk), type, Job(std::forward<F>(work)), 0.0f});
+    }
+
+    // Drops out-of-range jobs and hands the best pending ones to the pool
+    void dispatch(ThreadPool& pool);
+
+    // Forget all pending jobs (world switch); in-flight jobs still finish
+    void clear();
+
+    bool isInRange(const ChunkPos& pos) const;
+
+    size_t getPendingCount() const { return pending.size(); }
+    size_t getInFlightCount() const { return inFlight.load(); }
+    u64 getDroppedCount() const { return dropped.load(); }   // Cancelled, including failed jobs
+    u64 getFailedCount() const { return failed.load(); }     // Threw; their chunk is requested again
+
+private:
+    struct ChunkJob {
+        std::shared_ptr<Chunk> chunk;
+        ChunkJobType type;
+        Job work;
+        float priority; // Lower runs first
+    };
+
+    float computePriority(const ChunkPos& pos) const;
+    void cancel(ChunkJob& job);
+    void run(size_t slot);
+
+    std::vector<ChunkJob> pending;        // Main thread only
+    std::vector<ChunkJob> slots;          // In-flight jobs, owned by the running worker
+    std::vector<size_t> freeSlots;
+    std::mutex slotMutex;
+    std::atomic<size_t> inFlight{0};
+    std::atomic<u64> dropped{0};
+    std::atomic<u64> failed{0};
+
+    glm::vec3 cameraPos{0.0f};
+    glm::vec3 viewDir{0.0f, 0.0f, -1.0f};
+
+    // Read by workers when a job starts
+    std::atomic<int> centerX{0};
+    std::atomic<int> centerZ{0};
+    std::atomic<int> range{RENDER_DISTANCE + 2};
+};
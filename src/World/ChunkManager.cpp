@@ -1,36 +1,65 @@
 #include "ChunkManager.h"
+#include "BlockAccessor.h"
+#include "ChunkCodec.h"
+#include "../Mesh/Vertex.h"
 #include "../Core/Settings.h"
+#include "../Core/Logger.h"
 #include <cmath>
 #include <algorithm>
+#include <array>
 #include <filesystem>
 #include <fstream>
 #include <cstdlib>
 #include <set>
 
-ChunkManager::ChunkManager() {
+namespace {
+// All 26 neighbors a mesh reads (faces, edges, corners) in neighborhood order without
+// the center; the bit order of Chunk::getMeshedNeighbors
+const std::array<ChunkPos, 26> NEIGHBORS = [] {
+    std::array<ChunkPos, 26> offsets;
+    int i = 0;
+    for (int dy = -1; dy <= 1; ++dy) {
+        for (int dz = -1; dz <= 1; ++dz) {
+            for (int dx = -1; dx <= 1; ++dx) {
+                if (dx != 0 || dy != 0 || dz != 0) offsets[i++] = ChunkPos(dx, dy, dz);
+            }
+        }
+    }
+    return offsets;
+}();
+constexpr u32 ALL_NEIGHBORS = (1u << 26) - 1;
+}
+
+ChunkManager::ChunkManager()
+    : implicitSolid(std::make_shared<Chunk>(ChunkPos(0))) {
+    std::vector<Block> stone(CHUNK_VOLUME, Block(BlockType::STONE));
+    implicitSolid->setBlocks(stone.data());
 }
 
-void ChunkManager::update(const glm::vec3& cameraPos, const glm::vec3& /*viewDir*/, const glm::mat4& /*viewMatrix*/) {
+void ChunkManager::update(const glm::vec3& cameraPos, const glm::vec3& viewDir, const glm::mat4& /*viewMatrix*/) {
+    // Pending chunk jobs are ordered by this view and dropped outside the unload radius
+    jobScheduler.setView(cameraPos, viewDir, Settings::instance().renderDistance + 2);
+
     // Unload distant chunks
     unloadDistantChunks(cameraPos);
     updateFluids();
+
+    // Free unloaded chunks no worker can still be reading
+    chunks.reclaim();
 }
 
 int ChunkManager::getHeightAt(int x, int z) {
     // Scan from top down
     // Assumes reasonable bounds based on generation
+    BlockAccessor blocks(*this);
     for (int y = 256; y >= -64; --y) {
-        if (getBlockAt(x, y, z).getType() != BlockType::AIR) return y;
+        if (blocks.getBlock(x, y, z).getType() != BlockType::AIR) return y;
     }
     return 0;
 }
 
 std::shared_ptr<Chunk> ChunkManager::getChunk(const ChunkPos& pos) {
-    auto it = chunks.find(pos);
-    if (it != chunks.end()) {
-        return it->second;
-    }
-    return nullptr;
+    return chunks.get(pos);
 }
 
 std::shared_ptr<Chunk> ChunkManager::getChunkAt(const glm::vec3& worldPos) {
@@ -45,71 +74,193 @@ void ChunkManager::unloadDistantChunks(const glm::vec3& cameraPos) {
     
     auto now = std::chrono::duration_cast<std::chrono::duration<double>>(std::chrono::steady_clock::now().time_since_epoch()).count();
 
-    std::vector<ChunkPos> toEraseImmediately;
-    for (const auto& [pos, chunk] : chunks) {
-        if (!isChunkInRange(pos, centerChunk, renderDist + 2)) {
-            // Not in range; check if already marked for unload
-            auto it = unloadTimestamps.find(pos);
-            if (it == unloadTimestamps.end()) {
-                unloadTimestamps[pos] = now; // start grace timer
-            } else {
-                double elapsed = now - it->second;
-                if (elapsed >= UNLOAD_DELAY_SECONDS) {
-                    toEraseImmediately.push_back(pos);
-                }
+    // Which chunks are out of range only changes when the camera enters another column or
+    // the render distance changes; chunks loaded in between are always in range
+    if (renderDist != unloadRange || centerChunk.x != unloadCenter.x || centerChunk.z != unloadCenter.z) {
+        unloadCenter = centerChunk;
+        unloadRange = renderDist;
+        for (const auto& [pos, chunk] : chunks.items()) {
+            if (!isChunkInRange(pos, centerChunk, renderDist + 2)) {
+                parkedSince.try_emplace(pos, now);
+                continue;
             }
-        } else {
-            // In range -> ensure it's not pending unload
-            unloadTimestamps.erase(pos);
+            auto it = parkedSince.find(pos);
+            if (it == parkedSince.end()) continue;
+            // Back before it was evicted: its mesh was dropped, its blocks are still here
+            parkedSince.erase(it);
+            chunksRevived++;
+            if (chunk->getState() == ChunkState::GPU_UPLOADED) chunk->setState(ChunkState::MESH_BUILD);
         }
     }
 
-    // Erase chunks that exceeded the grace period
-    for (const auto& pos : toEraseImmediately) {
-        chunks.erase(pos);
-        unloadTimestamps.erase(pos);
+    if (now - lastBudgetCheck >= BUDGET_CHECK_SECONDS) {
+        lastBudgetCheck = now;
+        evictOverBudget(centerChunk, now);
+    }
+}
+
+void ChunkManager::evictOverBudget(const ChunkPos& centerChunk, double now) {
+    size_t budget = static_cast<size_t>(std::max(0, Settings::instance().chunkMemoryBudgetMB)) * 1024 * 1024;
+    lastResidentBytes = getResidentMemoryUsage();
+    if (lastResidentBytes <= budget || parkedSince.empty()) return;
+
+    // Far away and long gone first
+    struct Candidate {
+        ChunkPos pos;
+        float score;
+        size_t freed;
+    };
+    std::vector<Candidate> candidates;
+    candidates.reserve(parkedSince.size());
+    for (const auto& [pos, since] : parkedSince) {
+        auto it = chunks.items().find(pos);
+        if (it == chunks.items().end()) continue;
+        const Chunk& chunk = *it->second;
+        float dx = static_cast<float>(pos.x - centerChunk.x);
+        float dz = static_cast<float>(pos.z - centerChunk.z);
+        float score = std::sqrt(dx * dx + dz * dz) * EVICT_DISTANCE_WEIGHT + static_cast<float>(now - since) * EVICT_AGE_WEIGHT;
+        if (chunk.isModified()) score *= EVICT_MODIFIED_FACTOR;
+        size_t freed = chunk.isModified() ? sizeof(Chunk) : getChunkMemoryUsage(chunk, true);
+        candidates.push_back({pos, score, freed});
+    }
+    std::sort(candidates.begin(), candidates.end(),
+              [](const Candidate& a, const Candidate& b) { return a.score > b.score; });
+
+    for (const Candidate& candidate : candidates) {
+        if (lastResidentBytes <= budget) break;
+        unloadChunk(candidate.pos);
+        lastResidentBytes -= std::min(lastResidentBytes, candidate.freed);
+        chunksEvicted++;
+    }
+}
+
+void ChunkManager::unloadChunk(const ChunkPos& pos) {
+    parkedSince.erase(pos);
+    auto it = chunks.items().find(pos);
+    if (it == chunks.items().end()) return;
+    // Unsaved edits wait for the next save
+    if (it->second->isModified()) {
+        keepUnsavedChunk(pos, it->second->snapshot());
+    }
+    chunks.erase(pos);
+    meshWaitStart.erase(pos);
+}
+
+size_t ChunkManager::getChunkMemoryUsage(const Chunk& chunk, bool parked) const {
+    size_t bytes = sizeof(Chunk) + chunk.getMemoryUsage();
+    if (!parked) {
+        // The last mesh's size stands in for its GPU buffers
+        Chunk::MeshSizeHint mesh = chunk.getMeshSizeHint();
+        bytes += (static_cast<size_t>(mesh.vertices) + mesh.waterVertices) * sizeof(Vertex);
     }
+    return bytes;
+}
+
+size_t ChunkManager::getResidentMemoryUsage() {
+    size_t total = 0;
+    for (const auto& [pos, chunk] : chunks.items()) {
+        total += getChunkMemoryUsage(*chunk, isChunkParked(pos));
+    }
+    // Unloaded chunks waiting in the pool keep their storages and mip arrays
+    total += chunkPool.getStats().freeBytes;
+    std::lock_guard<std::mutex> lock(storageMutex);
+    for (const auto& [pos, snapshot] : unsavedChunks) {
+        total += snapshot.getMemoryUsage();
+    }
+    return total;
+}
+
+ChunkManager::EvictionStats ChunkManager::getEvictionStats() const {
+    EvictionStats stats;
+    stats.parked = parkedSince.size();
+    stats.residentBytes = lastResidentBytes;
+    stats.evicted = chunksEvicted;
+    stats.revived = chunksRevived;
+    return stats;
 }
 
 void ChunkManager::requestChunkGeneration(const ChunkPos& pos) {
-    if (chunks.find(pos) == chunks.end()) {
-        auto chunk = std::make_shared<Chunk>(pos);
-        chunks[pos] = chunk;
+    if (!chunks.find(pos)) {
+        chunks.insert(pos, chunkPool.acquire(pos));
     }
 }
 
 std::vector<ChunkPos> ChunkManager::getChunksToGenerate(const glm::vec3& cameraPos, int range, int maxChunks) {
     std::vector<ChunkPos> result;
     ChunkPos centerChunk = worldToChunk(cameraPos);
+    if (range != frontierRange || centerChunk.x != frontierCenter.x || centerChunk.z != frontierCenter.z) {
+        rebuildFrontier(centerChunk, range);
+    }
+
+    // Positions loaded since are dropped as they come up; the ones handed out are
+    // usually requested right away and dropped by the next call
+    ChunkMap::ReadGuard guard;
+    size_t kept = 0;
+    size_t scanned = 0;
+    for (; scanned < frontier.size() && result.size() < static_cast<size_t>(maxChunks); ++scanned) {
+        const ChunkPos& pos = frontier[scanned];
+        Chunk* chunk = chunks.find(pos);
+        if (chunk && chunk->getState() != ChunkState::UNLOADED) continue;
+        if (!chunk && worldGenerator) {
+            // First visit of a column computes its extent; sky and deep stone stay implicit
+            const WorldGenerator::ColumnExtent& extent = getColumnExtent(pos.x, pos.z);
+            if (pos.y < extent.minChunkY || pos.y > extent.maxChunkY) {
+                implicitChunkStats.skipped++;
+                continue;
+            }
+        }
+        result.push_back(pos);
+        frontier[kept++] = pos;
+    }
+    frontier.erase(frontier.begin() + kept, frontier.begin() + scanned);
     
-    // Generate in a spiral pattern around the player
-    for (int dist = 0; dist <= range && result.size() < static_cast<size_t>(maxChunks); ++dist) {
-        for (int x = -dist; x <= dist && result.size() < static_cast<size_t>(maxChunks); ++x) {
-            for (int z = -dist; z <= dist && result.size() < static_cast<size_t>(maxChunks); ++z) {
-                // Generate vertical column from bedrock (-4) to height limit (12)
-                for (int y = -4; y <= 12 && result.size() < static_cast<size_t>(maxChunks); ++y) {
-                    if (std::abs(x) != dist && std::abs(z) != dist) continue;
-                    
+    return result;
+}
+
+void ChunkManager::rebuildFrontier(const ChunkPos& centerChunk, int range) {
+    frontierCenter = centerChunk;
+    frontierRange = range;
+    frontier.clear();
+
+    // Extents of columns the player has left are recomputed if they come back in range
+    for (auto it = columnExtents.begin(); it != columnExtents.end();) {
+        if (isChunkInRange(it->first, centerChunk, range + 2)) ++it;
+        else it = columnExtents.erase(it);
+    }
+
+    // Missing chunks in load order: a spiral of rings around the player, each column
+    // from the bedrock floor to the height limit, minus the known implicit chunks
+    ChunkMap::ReadGuard guard;
+    for (int dist = 0; dist <= range; ++dist) {
+        for (int x = -dist; x <= dist; ++x) {
+            for (int z = -dist; z <= dist; ++z) {
+                if (std::abs(x) != dist && std::abs(z) != dist) continue;
+                for (int y = MIN_CHUNK_Y; y <= MAX_CHUNK_Y; ++y) {
                     ChunkPos pos(centerChunk.x + x, y, centerChunk.z + z);
-                    auto chunk = getChunk(pos);
-                    
-                    if (!chunk || chunk->getState() == ChunkState::UNLOADED) {
-                        result.push_back(pos);
+                    // Square corners beyond the unload radius would be unloaded again right away
+                    if (!isChunkInRange(pos, centerChunk, range + 2)) continue;
+                    Chunk* chunk = chunks.find(pos);
+                    if (chunk ? chunk->getState() == ChunkState::UNLOADED : getImplicitChunk(pos) == ImplicitChunk::NONE) {
+                        frontier.push_back(pos);
                     }
                 }
             }
         }
     }
-    
-    return result;
 }
 
 std::vector<std::shared_ptr<Chunk>> ChunkManager::getChunksToMesh(const glm::vec3& cameraPos, int maxChunks) {
     std::vector<std::shared_ptr<Chunk>> candidates;
     ChunkPos centerChunk = worldToChunk(cameraPos);
+    int unloadRange = Settings::instance().renderDistance + 2;
+    ChunkMap::ReadGuard guard;
+    auto now = std::chrono::duration_cast<std::chrono::duration<double>>(std::chrono::steady_clock::now().time_since_epoch()).count();
     
     // 1. Collect all chunks that need meshing
-    for (const auto& [pos, chunk] : chunks) {
+    for (const auto& [pos, chunk] : chunks.items()) {
+        // Chunks waiting out their unload grace period aren't worth meshing
+        if (!isChunkInRange(pos, centerChunk, unloadRange)) continue;
+
         int desiredLOD = getDesiredLOD(pos, cameraPos);
         
         // Force update if LOD is wrong, even if state is "stable" (READY/GPU_UPLOADED)
@@ -120,12 +271,47 @@ std::vector<std::shared_ptr<Chunk>> ChunkManager::getChunksToMesh(const glm::vec
              if (chunk->getState() != ChunkState::GENERATING && chunk->getState() != ChunkState::UNLOADED) {
                  chunk->setCurrentLOD(desiredLOD);
                  chunk->setState(ChunkState::MESH_BUILD);
+
+                 // Neighbors mesh their shared border against this chunk's LOD (seam faces).
+                 // LOD only depends on x/z, so only the four horizontal neighbors can differ.
+                 const ChunkPos sides[4] = {ChunkPos(1, 0, 0), ChunkPos(-1, 0, 0), ChunkPos(0, 0, 1), ChunkPos(0, 0, -1)};
+                 for (const ChunkPos& side : sides) {
+                     Chunk* neighbor = chunks.find(pos + side);
+                     if (neighbor && neighbor->getState() == ChunkState::GPU_UPLOADED) {
+                         neighbor->setState(ChunkState::MESH_BUILD);
+                     }
+                 }
              }
         }
 
-        if (chunk->getState() == ChunkState::MESH_BUILD) {
-            candidates.push_back(chunk);
+        // An all-air mesh is empty whatever its neighbors are
+        Block uniform;
+        bool airOnly = chunk->getUniformBlock(uniform) && uniform.getType() == BlockType::AIR;
+
+        if (chunk->getState() == ChunkState::GPU_UPLOADED && !airOnly && chunk->getMeshedNeighbors() != ALL_NEIGHBORS) {
+            // Meshed while a neighbor was missing or still generating: its border faces and AO
+            // are stale now that the neighbor is there
+            u32 generated, pending;
+            getNeighborGeneration(pos, generated, pending);
+            if (generated & ~chunk->getMeshedNeighbors()) {
+                chunk->setState(ChunkState::MESH_BUILD);
+                meshScheduleStats.neighborRebuilds++;
+            }
+        }
+
+        if (chunk->getState() != ChunkState::MESH_BUILD) continue;
+
+        if (!airOnly) {
+            // Mesh once every neighbor is done generating instead of now and again per neighbor
+            u32 generated, pending;
+            getNeighborGeneration(pos, generated, pending);
+            if (pending) {
+                auto [it, waiting] = meshWaitStart.try_emplace(pos, now);
+                if (waiting) meshScheduleStats.deferred++;
+                if (now - it->second < MESH_NEIGHBOR_TIMEOUT_SECONDS) continue;
+            }
         }
+        candidates.push_back(chunk);
     }
 
     // 2. Sort by distance to player (closest first)
@@ -145,10 +331,53 @@ std::vector<std::shared_ptr<Chunk>> ChunkManager::getChunksToMesh(const glm::vec
     if (candidates.size() > static_cast<size_t>(maxChunks)) {
         candidates.resize(maxChunks);
     }
+
+    // Remember which neighbors these meshes see, so a later arrival re-queues them
+    for (const auto& chunk : candidates) {
+        u32 generated, pending;
+        getNeighborGeneration(chunk->getPosition(), generated, pending);
+        Block uniform;
+        bool airOnly = chunk->getUniformBlock(uniform) && uniform.getType() == BlockType::AIR;
+        chunk->setMeshedNeighbors(airOnly ? ALL_NEIGHBORS : generated);
+
+        auto it = meshWaitStart.find(chunk->getPosition());
+        if (it != meshWaitStart.end()) {
+            if (pending) meshScheduleStats.timeouts++;
+            else meshScheduleStats.rebuildsAvoided++;
+            meshWaitStart.erase(it);
+        }
+    }
     
     return candidates;
 }
 
+void ChunkManager::getNeighborGeneration(const ChunkPos& pos, u32& generated, u32& pending) const {
+    generated = 0;
+    pending = 0;
+    for (int i = 0; i < static_cast<int>(NEIGHBORS.size()); ++i) {
+        Chunk* neighbor = chunks.find(pos + NEIGHBORS[i]);
+        if (!neighbor) {
+            // Implicit chunks are final, like generated ones
+            if (getImplicitChunk(pos + NEIGHBORS[i]) != ImplicitChunk::NONE) generated |= 1u << i;
+            continue;
+        }
+        ChunkState state = neighbor->getState();
+        if (state == ChunkState::UNLOADED || state == ChunkState::GENERATING) {
+            pending |= 1u << i;
+        } else {
+            generated |= 1u << i;
+        }
+    }
+}
+
+size_t ChunkManager::getBlockMemoryUsage() const {
+    size_t total = 0;
+    for (const auto& [pos, chunk] : chunks.items()) {
+        total += chunk->getMemoryUsage();
+    }
+    return total;
+}
+
 int ChunkManager::getDesiredLOD(const ChunkPos& chunkPos, const glm::vec3& cameraPos) const {
     ChunkPos centerChunk = worldToChunk(cameraPos);
     int dx = std::abs(chunkPos.x - centerChunk.x);
@@ -205,18 +434,16 @@ ChunkManager::RayCastResult ChunkManager::rayCast(const glm::vec3& origin, const
     float t = 0.0f;
     glm::ivec3 normal(0);
 
+    BlockAccessor blocks(*this);
     while (t <= maxDistance) {
-        Block block = getBlockAt(x, y, z);
+        Block block = blocks.getBlock(x, y, z);
         if (block.getType() != BlockType::AIR && block.getType() != BlockType::WATER) {
             result.hit = true;
             result.distance = t;
             result.normal = normal;
             
-            glm::vec3 worldPos(x + 0.5f, y + 0.5f, z + 0.5f);
-            result.chunkPos = worldToChunk(worldPos);
-            
-            glm::vec3 chunkOrigin = chunkToWorld(result.chunkPos);
-            result.blockPos = glm::ivec3(x, y, z) - glm::ivec3(chunkOrigin);
+            result.chunkPos = BlockAccessor::toChunkPos(x, y, z);
+            result.blockPos = glm::ivec3(x, y, z) - result.chunkPos * glm::ivec3(CHUNK_SIZE, CHUNK_HEIGHT, CHUNK_SIZE);
             
             return result;
         }
@@ -252,31 +479,28 @@ ChunkManager::RayCastResult ChunkManager::rayCast(const glm::vec3& origin, const
 }
 
 Block ChunkManager::getBlockAt(int x, int y, int z) {
-    glm::vec3 worldPos(x + 0.5f, y + 0.5f, z + 0.5f);
-    ChunkPos chunkPos = worldToChunk(worldPos);
-    auto chunk = getChunk(chunkPos);
+    ChunkPos chunkPos = BlockAccessor::toChunkPos(x, y, z);
+    ChunkMap::ReadGuard guard;
+    Chunk* chunk = chunks.find(chunkPos);
     if (chunk) {
-        glm::vec3 chunkOrigin = chunkToWorld(chunkPos);
-        int lx = x - static_cast<int>(chunkOrigin.x);
-        int ly = y - static_cast<int>(chunkOrigin.y);
-        int lz = z - static_cast<int>(chunkOrigin.z);
-        
-        if (lx >= 0 && lx < CHUNK_SIZE && ly >= 0 && ly < CHUNK_HEIGHT && lz >= 0 && lz < CHUNK_SIZE) {
-            return chunk->getBlock(lx, ly, lz);
-        }
+        return chunk->getBlock(x - chunkPos.x * CHUNK_SIZE, y - chunkPos.y * CHUNK_HEIGHT, z - chunkPos.z * CHUNK_SIZE);
+    } else if (getImplicitChunk(chunkPos) == ImplicitChunk::SOLID) {
+        return Block(y <= WorldGenerator::BEDROCK_Y ? BlockType::BEDROCK : BlockType::STONE);
     }
     return Block(BlockType::AIR);
 }
 
 void ChunkManager::setBlockAt(int x, int y, int z, Block block) {
-    glm::vec3 worldPos(x + 0.5f, y + 0.5f, z + 0.5f);
-    ChunkPos chunkPos = worldToChunk(worldPos);
-    auto chunk = getChunk(chunkPos);
+    ChunkPos chunkPos = BlockAccessor::toChunkPos(x, y, z);
+    ChunkMap::ReadGuard guard;
+    Chunk* chunk = chunks.find(chunkPos);
+    if (!chunk && getBlockAt(x, y, z) != block) {
+        chunk = materializeChunk(chunkPos);
+    }
     if (chunk) {
-        glm::vec3 chunkOrigin = chunkToWorld(chunkPos);
-        int lx = x - static_cast<int>(chunkOrigin.x);
-        int ly = y - static_cast<int>(chunkOrigin.y);
-        int lz = z - static_cast<int>(chunkOrigin.z);
+        int lx = x - chunkPos.x * CHUNK_SIZE;
+        int ly = y - chunkPos.y * CHUNK_HEIGHT;
+        int lz = z - chunkPos.z * CHUNK_SIZE;
         
         if (lx >= 0 && lx < CHUNK_SIZE && ly >= 0 && ly < CHUNK_HEIGHT && lz >= 0 && lz < CHUNK_SIZE) {
             Block currentBlock = chunk->getBlock(lx, ly, lz);
@@ -284,6 +508,7 @@ void ChunkManager::setBlockAt(int x, int y, int z, Block block) {
 
             chunk->setBlock(lx, ly, lz, block);
             chunk->setDirty(true);
+            chunk->markEdited();
             chunk->setState(ChunkState::MESH_BUILD);
 
             // Fluid updates
@@ -303,34 +528,91 @@ void ChunkManager::setBlockAt(int x, int y, int z, Block block) {
                 }
             }
             
-            // Update neighbors if on boundary
-            if (lx == 0) {
-                auto neighbor = getChunk(chunkPos + ChunkPos(-1, 0, 0));
-                if (neighbor) neighbor->setState(ChunkState::MESH_BUILD);
-            } else if (lx == CHUNK_SIZE - 1) {
-                auto neighbor = getChunk(chunkPos + ChunkPos(1, 0, 0));
-                if (neighbor) neighbor->setState(ChunkState::MESH_BUILD);
-            }
-            
-            if (ly == 0) {
-                auto neighbor = getChunk(chunkPos + ChunkPos(0, -1, 0));
-                if (neighbor) neighbor->setState(ChunkState::MESH_BUILD);
-            } else if (ly == CHUNK_HEIGHT - 1) {
-                auto neighbor = getChunk(chunkPos + ChunkPos(0, 1, 0));
-                if (neighbor) neighbor->setState(ChunkState::MESH_BUILD);
-            }
-            
-            if (lz == 0) {
-                auto neighbor = getChunk(chunkPos + ChunkPos(0, 0, -1));
-                if (neighbor) neighbor->setState(ChunkState::MESH_BUILD);
-            } else if (lz == CHUNK_SIZE - 1) {
-                auto neighbor = getChunk(chunkPos + ChunkPos(0, 0, 1));
-                if (neighbor) neighbor->setState(ChunkState::MESH_BUILD);
-            }
+            // Update neighbors if on boundary. An implicit stone neighbor whose blocks this
+            // exposes needs a mesh of its own now.
+            auto wakeNeighbor = [&](const ChunkPos& offset) {
+                Chunk* neighbor = chunks.find(chunkPos + offset);
+                if (!neighbor && !block.isOpaque() && getImplicitChunk(chunkPos + offset) == ImplicitChunk::SOLID) {
+                    neighbor = materializeChunk(chunkPos + offset);
+                }
+                if (neighbor) {
+                    neighbor->markEdited();
+                    neighbor->setState(ChunkState::MESH_BUILD);
+                }
+            };
+            if (lx == 0) wakeNeighbor(ChunkPos(-1, 0, 0));
+            else if (lx == CHUNK_SIZE - 1) wakeNeighbor(ChunkPos(1, 0, 0));
+
+            if (ly == 0) wakeNeighbor(ChunkPos(0, -1, 0));
+            else if (ly == CHUNK_HEIGHT - 1) wakeNeighbor(ChunkPos(0, 1, 0));
+
+            if (lz == 0) wakeNeighbor(ChunkPos(0, 0, -1));
+            else if (lz == CHUNK_SIZE - 1) wakeNeighbor(ChunkPos(0, 0, 1));
         }
     }
 }
 
+ChunkManager::ImplicitChunk ChunkManager::getImplicitChunk(const ChunkPos& pos) const {
+    auto it = columnExtents.find(ChunkPos(pos.x, 0, pos.z));
+    if (it == columnExtents.end()) return ImplicitChunk::NONE;
+    if (pos.y >= MIN_CHUNK_Y && pos.y < it->second.minChunkY) return ImplicitChunk::SOLID;
+    if (pos.y <= MAX_CHUNK_Y && pos.y > it->second.maxChunkY) return ImplicitChunk::SKY;
+    return ImplicitChunk::NONE;
+}
+
+const WorldGenerator::ColumnExtent& ChunkManager::getColumnExtent(int chunkX, int chunkZ) {
+    ChunkPos column(chunkX, 0, chunkZ);
+    auto it = columnExtents.find(column);
+    if (it != columnExtents.end()) return it->second;
+
+    // Chunks materialized earlier are loaded / kept like any other, so the extent covers them
+    WorldGenerator::ColumnExtent extent = worldGenerator->getColumnExtent(chunkX, chunkZ);
+    ChunkMap::ReadGuard guard;
+    for (int y = MIN_CHUNK_Y; y < extent.minChunkY; ++y) {
+        ChunkPos pos(chunkX, y, chunkZ);
+        if (chunks.find(pos) || hasSavedChunk(pos)) {
+            extent.minChunkY = y;
+            break;
+        }
+    }
+    for (int y = MAX_CHUNK_Y; y > extent.maxChunkY; --y) {
+        ChunkPos pos(chunkX, y, chunkZ);
+        if (chunks.find(pos) || hasSavedChunk(pos)) {
+            extent.maxChunkY = y;
+            break;
+        }
+    }
+    return columnExtents.emplace(column, extent).first->second;
+}
+
+bool ChunkManager::hasSavedChunk(const ChunkPos& pos) {
+    std::shared_ptr<RegionStorage> storage;
+    {
+        std::lock_guard<std::mutex> lock(storageMutex);
+        if (unsavedChunks.count(pos)) return true;
+        storage = regionStorage;
+    }
+    return storage && storage->hasChunk(pos);
+}
+
+Chunk* ChunkManager::materializeChunk(const ChunkPos& pos) {
+    ImplicitChunk kind = getImplicitChunk(pos);
+    if (kind == ImplicitChunk::NONE) return nullptr;
+
+    auto chunk = chunkPool.acquire(pos);
+    if (kind == ImplicitChunk::SOLID) {
+        worldGenerator->generate(chunk); // Stone on the bedrock floor, no caves
+    } else {
+        chunk->setState(ChunkState::MESH_BUILD);
+    }
+    // Saved even if left unedited, so a reload doesn't turn it implicit again next to edits
+    chunk->setModified(true);
+    Chunk* result = chunk.get();
+    chunks.insert(pos, std::move(chunk));
+    implicitChunkStats.materialized++;
+    return result;
+}
+
 std::vector<std::shared_ptr<Chunk>> ChunkManager::getNeighbors(const ChunkPos& pos) {
     std::vector<std::shared_ptr<Chunk>> neighbors(6);
     neighbors[0] = getChunk(pos + ChunkPos(1, 0, 0));  // X+
@@ -342,26 +624,106 @@ std::vector<std::shared_ptr<Chunk>> ChunkManager::getNeighbors(const ChunkPos& p
     return neighbors;
 }
 
-void ChunkManager::preloadChunkData(const ChunkPos& pos, const std::vector<Block>& blocks) {
-    preloadedChunks[pos] = blocks;
+ChunkNeighborhood ChunkManager::getNeighborhood(const ChunkPos& pos) {
+    return getNeighborhood(pos, getImplicitSolidNeighbors(pos));
+}
+
+u32 ChunkManager::getImplicitSolidNeighbors(const ChunkPos& pos) const {
+    u32 mask = 0;
+    for (int dy = -1; dy <= 1; ++dy) {
+        for (int dz = -1; dz <= 1; ++dz) {
+            for (int dx = -1; dx <= 1; ++dx) {
+                if (getImplicitChunk(pos + ChunkPos(dx, dy, dz)) == ImplicitChunk::SOLID) {
+                    mask |= 1u << ((dy + 1) * 9 + (dz + 1) * 3 + (dx + 1));
+                }
+            }
+        }
+    }
+    return mask;
+}
+
+ChunkNeighborhood ChunkManager::getNeighborhood(const ChunkPos& pos, u32 implicitSolidNeighbors) const {
+    ChunkNeighborhood neighborhood;
+    ChunkMap::ReadGuard guard;
+    for (int dy = -1; dy <= 1; ++dy) {
+        for (int dz = -1; dz <= 1; ++dz) {
+            for (int dx = -1; dx <= 1; ++dx) {
+                Chunk* chunk = chunks.find(pos + ChunkPos(dx, dy, dz));
+                int index = (dy + 1) * 9 + (dz + 1) * 3 + (dx + 1);
+                if (chunk) neighborhood[index] = chunk->shared_from_this();
+                // Implicit sky reads as air like a missing chunk; implicit stone must cull faces
+                else if (implicitSolidNeighbors & (1u << index)) neighborhood[index] = implicitSolid;
+            }
+        }
+    }
+    return neighborhood;
+}
+
+void ChunkManager::setRegionStorage(std::shared_ptr<RegionStorage> storage) {
+    std::lock_guard<std::mutex> lock(storageMutex);
+    regionStorage = std::move(storage);
 }
 
-bool ChunkManager::hasPreloadedData(const ChunkPos& pos) const {
-    return preloadedChunks.find(pos) != preloadedChunks.end();
+std::shared_ptr<RegionStorage> ChunkManager::getRegionStorage() {
+    std::lock_guard<std::mutex> lock(storageMutex);
+    return regionStorage;
 }
 
-std::vector<Block> ChunkManager::consumePreloadedData(const ChunkPos& pos) {
-    auto it = preloadedChunks.find(pos);
-    if (it != preloadedChunks.end()) {
-        std::vector<Block> blocks = std::move(it->second);
-        preloadedChunks.erase(it);
-        return blocks;
+bool ChunkManager::loadSavedChunk(const std::shared_ptr<Chunk>& chunk) {
+    const ChunkPos& pos = chunk->getPosition();
+    std::shared_ptr<RegionStorage> storage;
+    {
+        std::lock_guard<std::mutex> lock(storageMutex);
+        auto it = unsavedChunks.find(pos);
+        if (it != unsavedChunks.end()) {
+            // The entry stays until a save writes it; the chunk only needs its contents
+            std::vector<Block> blocks(CHUNK_VOLUME);
+            it->second.copyBlocks(blocks.data());
+            chunk->setBlocks(blocks.data());
+            chunk->setModified(false);
+            return true;
+        }
+        storage = regionStorage;
+    }
+    if (!storage) return false;
+
+    std::vector<u8> payload;
+    if (!storage->readChunk(pos, payload)) return false;
+
+    std::vector<Block> blocks(CHUNK_VOLUME);
+    if (!ChunkCodec::decode(payload, blocks.data())) {
+        LOG_ERROR("Corrupt saved chunk at " + std::to_string(pos.x) + ", " + std::to_string(pos.y) + ", " + std::to_string(pos.z));
+        return false;
     }
-    return {};
+    chunk->setBlocks(blocks.data());
+    chunk->setModified(false);
+    return true;
 }
 
-std::vector<Block> ChunkManager::getPreloadedData(const ChunkPos& pos) {
-    return consumePreloadedData(pos);
+void ChunkManager::keepUnsavedChunk(const ChunkPos& pos, Chunk::Snapshot snapshot) {
+    std::lock_guard<std::mutex> lock(storageMutex);
+    unsavedChunks[pos] = std::move(snapshot);
+}
+
+std::vector<std::pair<ChunkPos, Chunk::Snapshot>> ChunkManager::snapshotUnsavedChunks() {
+    std::lock_guard<std::mutex> lock(storageMutex);
+    for (const auto& [pos, chunk] : chunks.items()) {
+        if (!chunk->isModified()) continue;
+        // Cleared before the snapshot: an edit racing with it marks the chunk again
+        chunk->setModified(false);
+        unsavedChunks[pos] = chunk->snapshot();
+    }
+    return std::vector<std::pair<ChunkPos, Chunk::Snapshot>>(unsavedChunks.begin(), unsavedChunks.end());
+}
+
+void ChunkManager::markChunksSaved(const std::vector<std::pair<ChunkPos, Chunk::Snapshot>>& saved) {
+    std::lock_guard<std::mutex> lock(storageMutex);
+    for (const auto& [pos, snapshot] : saved) {
+        auto it = unsavedChunks.find(pos);
+        if (it != unsavedChunks.end() && it->second == snapshot) {
+            unsavedChunks.erase(it);
+        }
+    }
 }
 
 void ChunkManager::scheduleFluidUpdate(int x, int y, int z) {
@@ -405,6 +767,7 @@ void ChunkManager::updateFluids() {
     };
     
     std::set<glm::ivec3, Vec3Less> processed;
+    BlockAccessor blocks(*this);
     
     for (const auto& pos : currentQueue) {
         if (processed.count(pos)) continue;
@@ -414,7 +777,7 @@ void ChunkManager::updateFluids() {
         int y = pos.y;
         int z = pos.z;
         
-        Block block = getBlockAt(x, y, z);
+        Block block = blocks.getBlock(x, y, z);
         if (block.getType() != BlockType::WATER) continue;
         
         u8 level = block.getData();
@@ -428,7 +791,7 @@ void ChunkManager::updateFluids() {
             int dz[] = {0, 0, 1, -1};
             
             for (int j = 0; j < 4; ++j) {
-                Block neighbor = getBlockAt(x + dx[j], y, z + dz[j]);
+                Block neighbor = blocks.getBlock(x + dx[j], y, z + dz[j]);
                 if (neighbor.getType() == BlockType::WATER && neighbor.getData() == 0) {
                     sourceNeighbors++;
                 }
@@ -437,9 +800,9 @@ void ChunkManager::updateFluids() {
             if (sourceNeighbors >= 2) {
                 // Become source block
                 // Only if there is a solid block underneath (or water)
-                Block down = getBlockAt(x, y - 1, z);
+                Block down = blocks.getBlock(x, y - 1, z);
                 if (down.isSolid() || down.getType() == BlockType::WATER) {
-                    setBlockAt(x, y, z, Block(BlockType::WATER, 0));
+                    blocks.setBlock(x, y, z, Block(BlockType::WATER, 0));
                     continue; // Done with this block
                 }
             }
@@ -448,10 +811,10 @@ void ChunkManager::updateFluids() {
         if (block.getType() != BlockType::WATER) continue;
         
         // 1. Try to flow down
-        Block down = getBlockAt(x, y - 1, z);
+        Block down = blocks.getBlock(x, y - 1, z);
         if (down.getType() == BlockType::AIR || (down.getType() == BlockType::WATER && down.getData() != 0)) {
             // Flow down (reset level to 1 for falling water)
-            setBlockAt(x, y - 1, z, Block(BlockType::WATER, 1));
+            blocks.setBlock(x, y - 1, z, Block(BlockType::WATER, 1));
         } else if (down.isSolid() || (down.getType() == BlockType::WATER && down.getData() == 0)) {
             // 2. If blocked below, flow sideways
             // Only if current level < 7
@@ -464,10 +827,10 @@ void ChunkManager::updateFluids() {
                 int dz[] = {0, 0, 1, -1};
                 
                 for (int j = 0; j < 4; ++j) {
-                    Block neighbor = getBlockAt(x + dx[j], y, z + dz[j]);
+                    Block neighbor = blocks.getBlock(x + dx[j], y, z + dz[j]);
                     if (neighbor.getType() == BlockType::AIR || (neighbor.getType() == BlockType::WATER && neighbor.getData() > nextLevel)) {
                         // Flow into air OR into water that is "lower" (higher data value)
-                        setBlockAt(x + dx[j], y, z + dz[j], Block(BlockType::WATER, nextLevel));
+                        blocks.setBlock(x + dx[j], y, z + dz[j], Block(BlockType::WATER, nextLevel));
                     }
                 }
             }
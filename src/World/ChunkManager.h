@@ -3,6 +3,11 @@
 #include "../Util/Types.h"
 #include "../Util/Config.h"
 #include "Chunk.h"
+#include "ChunkJobScheduler.h"
+#include "ChunkMap.h"
+#include "ChunkPool.h"
+#include "RegionFile.h"
+#include "WorldGenerator.h"
 #include <unordered_map>
 #include <unordered_set>
 #include <memory>
@@ -24,25 +29,78 @@ public:
     
     std::shared_ptr<Chunk> getChunk(const ChunkPos& pos);
     std::shared_ptr<Chunk> getChunkAt(const glm::vec3& worldPos);
+    // Lock-free, no refcount; only valid inside a ChunkMap::ReadGuard
+    Chunk* findChunk(const ChunkPos& pos) const { return chunks.find(pos); }
     int getHeightAt(int x, int z);
+    // Main thread: also answers for implicit chunks (see setWorldGenerator). Loops over
+    // many blocks should use a BlockAccessor.
     Block getBlockAt(int x, int y, int z);
     
-    const std::unordered_map<ChunkPos, std::shared_ptr<Chunk>>& getChunks() const {
-        return chunks;
+    // Main thread only (the thread that loads / unloads chunks)
+    const ChunkMap::Items& getChunks() const {
+        return chunks.items();
     }
     
-    void unloadAll() { chunks.clear(); }
+    void unloadAll() {
+        chunks.clear();
+        invalidateStreaming();
+    }
     void unloadDistantChunks(const glm::vec3& cameraPos);
     void requestChunkGeneration(const ChunkPos& pos);
     
+    // Missing chunks in load order (closest rings first). The frontier of missing positions is
+    // only rebuilt when the camera enters another chunk column or the range changes; other
+    // calls just pop the positions that have been loaded since.
     std::vector<ChunkPos> getChunksToGenerate(const glm::vec3& cameraPos, int range, int maxChunks);
+    // Chunks to mesh now, closest first. A chunk waits (up to MESH_NEIGHBOR_TIMEOUT_SECONDS)
+    // while a neighbor (face, edge or corner) is still generating, and a meshed chunk is queued again once a
+    // neighbor it was meshed without has finished generating.
     std::vector<std::shared_ptr<Chunk>> getChunksToMesh(const glm::vec3& cameraPos, int maxChunks);
 
+    // Neighbor-aware mesh scheduling stats (main thread)
+    struct MeshScheduleStats {
+        u64 deferred = 0;          // Chunks that waited for a generating neighbor
+        u64 rebuildsAvoided = 0;   // ... and were meshed once it was done, instead of again afterwards
+        u64 timeouts = 0;          // ... and were meshed without it after the timeout
+        u64 neighborRebuilds = 0;  // Re-meshes because a neighbor finished generating later
+    };
+    const MeshScheduleStats& getMeshScheduleStats() const { return meshScheduleStats; }
+
+    // Heightmap-aware columns: with a generator set, the chunks of a column below / above
+    // WorldGenerator::getColumnExtent are implicit (stone / sky, never saved). They get no
+    // storage, generation job, mesh or renderer entry; setBlockAt materializes them.
+    void setWorldGenerator(WorldGenerator* generator) { worldGenerator = generator; }
+
+    struct ImplicitChunkStats {
+        u64 skipped = 0;       // Positions handed over by the load frontier as implicit
+        u64 materialized = 0;  // Implicit chunks turned into real ones by an edit
+    };
+    const ImplicitChunkStats& getImplicitChunkStats() const { return implicitChunkStats; }
+
     static ChunkPos worldToChunk(const glm::vec3& worldPos);
     static glm::vec3 chunkToWorld(const ChunkPos& chunkPos);
 
     int getDesiredLOD(const ChunkPos& chunkPos, const glm::vec3& cameraPos) const;
 
+    // Resident block storage (paletted) and mip arrays across all loaded chunks
+    size_t getBlockMemoryUsage() const;
+
+    // Chunks that leave the unload radius are parked: their blocks stay resident (the renderer
+    // drops their mesh) until the memory budget (Settings::chunkMemoryBudgetMB) needs the space.
+    // Walking back re-meshes a parked chunk instead of generating it again.
+    bool isChunkParked(const ChunkPos& pos) const { return parkedSince.count(pos) != 0; }
+    // Blocks, mip arrays and chunk objects (including the pool's free chunks), mesh sizes of
+    // unparked chunks and unsaved snapshots (main thread)
+    size_t getResidentMemoryUsage();
+
+    struct EvictionStats {
+        size_t parked = 0;
+        size_t residentBytes = 0;  // As of the last budget check
+        u64 evicted = 0;
+        u64 revived = 0;           // Parked chunks back in range before they were evicted
+    };
+    EvictionStats getEvictionStats() const;
+
     struct RayCastResult {
         bool hit = false;
         ChunkPos chunkPos;
@@ -53,6 +111,7 @@ public:
 
     RayCastResult rayCast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance);
     
+    // Main thread
     void setBlockAt(int x, int y, int z, Block block);
     
     // Fluid simulation
@@ -61,33 +120,115 @@ public:
 
     // Helper to get neighbors for meshing
     std::vector<std::shared_ptr<Chunk>> getNeighbors(const ChunkPos& pos);
+    ChunkNeighborhood getNeighborhood(const ChunkPos& pos); // Includes edge / corner neighbors
+    // For mesh jobs: the main thread takes the implicit stone neighbors (bit i = neighborhood
+    // index i), a worker then gathers the loaded ones itself, so the job captures 4 bytes
+    // instead of 27 shared_ptrs
+    u32 getImplicitSolidNeighbors(const ChunkPos& pos) const;
+    ChunkNeighborhood getNeighborhood(const ChunkPos& pos, u32 implicitSolidNeighbors) const; // Any thread
 
     void setWorldName(const std::string& name) { currentWorldName = name; }
+    ChunkJobScheduler& getJobScheduler() { return jobScheduler; }
+    // Every loaded chunk comes from here
+    ChunkPool& getChunkPool() { return chunkPool; }
+
     void clear() { 
         chunks.clear(); 
-        preloadedChunks.clear();
+        jobScheduler.clear();
+        {
+            std::lock_guard<std::mutex> lock(storageMutex);
+            unsavedChunks.clear();
+            regionStorage.reset();
+        }
+        meshWaitStart.clear();
+        invalidateStreaming();
         std::lock_guard<std::mutex> lock(fluidMutex);
         fluidQueue.clear();
         pendingFluidUpdates.clear();
     }
     
-    // Modified chunk cache for single-file loading
-    void preloadChunkData(const ChunkPos& pos, const std::vector<Block>& blocks);
-    bool hasPreloadedData(const ChunkPos& pos) const;
-    std::vector<Block> consumePreloadedData(const ChunkPos& pos);
-    std::vector<Block> getPreloadedData(const ChunkPos& pos);
+    // Saved chunks: region files of the current world, plus snapshots of edited chunks
+    // that are not on disk yet (unloaded before a save, or a save still in flight)
+    void setRegionStorage(std::shared_ptr<RegionStorage> storage);
+    std::shared_ptr<RegionStorage> getRegionStorage();
+    bool loadSavedChunk(const std::shared_ptr<Chunk>& chunk); // false = never saved, generate it
+    void keepUnsavedChunk(const ChunkPos& pos, Chunk::Snapshot snapshot);
+
+    // Main thread: snapshots every modified loaded chunk (copy-on-write, clears the
+    // flag) and returns all chunks that still have to be written
+    std::vector<std::pair<ChunkPos, Chunk::Snapshot>> snapshotUnsavedChunks();
+    // Drops the written snapshots, unless the chunk was snapshotted again meanwhile
+    void markChunksSaved(const std::vector<std::pair<ChunkPos, Chunk::Snapshot>>& saved);
 
 private:
-    std::unordered_map<ChunkPos, std::shared_ptr<Chunk>> chunks;
-    std::unordered_map<ChunkPos, std::vector<Block>> preloadedChunks;
+    friend class BlockAccessor;
+
+    ChunkPool chunkPool; // Declared first: outlives the chunks it hands out
+    ChunkMap chunks;
+    std::unordered_map<ChunkPos, Chunk::Snapshot> unsavedChunks;
+    std::shared_ptr<RegionStorage> regionStorage;
+    std::mutex storageMutex; // Guards unsavedChunks / regionStorage (read by generation jobs)
     std::deque<glm::ivec3> fluidQueue;
     std::unordered_set<glm::ivec3> pendingFluidUpdates;
     std::mutex fluidMutex;
     std::string currentWorldName;
+    ChunkJobScheduler jobScheduler;
+
+    // Parked chunks with the time they left the unload radius (seconds)
+    std::unordered_map<ChunkPos, double> parkedSince;
+    double lastBudgetCheck = 0.0;
+    size_t lastResidentBytes = 0;
+    u64 chunksEvicted = 0;
+    u64 chunksRevived = 0;
+    static constexpr double BUDGET_CHECK_SECONDS = 1.0;
+    // Eviction order: highest score first. Edited chunks free little (their blocks wait in
+    // unsavedChunks for the next save), so they go last.
+    static constexpr float EVICT_DISTANCE_WEIGHT = 1.0f;  // per chunk from the camera
+    static constexpr float EVICT_AGE_WEIGHT = 0.1f;       // per second parked
+    static constexpr float EVICT_MODIFIED_FACTOR = 0.25f;
+    void evictOverBudget(const ChunkPos& centerChunk, double now);
+    size_t getChunkMemoryUsage(const Chunk& chunk, bool parked) const;
+    void unloadChunk(const ChunkPos& pos);
+    // Camera column / render distance of the last out-of-range scan (-1 = rescan)
+    ChunkPos unloadCenter{0};
+    int unloadRange = -1;
+
+    // Load frontier: missing positions in load order for frontierCenter / frontierRange (-1 = rebuild)
+    std::deque<ChunkPos> frontier;
+    ChunkPos frontierCenter{0};
+    int frontierRange = -1;
+    void rebuildFrontier(const ChunkPos& centerChunk, int range);
 
-    // Delayed unload support: mark chunks for unload and only erase after a grace period
-    std::unordered_map<ChunkPos, double> unloadTimestamps; // seconds since epoch
-    static constexpr double UNLOAD_DELAY_SECONDS = 5.0; // keep chunks for 5s after leaving range
+    // After the chunk set was replaced wholesale (world switch)
+    void invalidateStreaming() {
+        frontier.clear();
+        frontierRange = -1;
+        unloadRange = -1;
+        parkedSince.clear();
+        columnExtents.clear();
+    }
+
+    // Implicit chunks (main thread). Extents are computed when the load frontier reaches a
+    // column, widened to cover every saved chunk, and dropped once the column is out of range.
+    enum class ImplicitChunk { NONE, SOLID, SKY };
+    WorldGenerator* worldGenerator = nullptr;
+    std::unordered_map<ChunkPos, WorldGenerator::ColumnExtent> columnExtents; // Keyed by (x, 0, z)
+    std::shared_ptr<Chunk> implicitSolid; // Stands in for implicit stone in mesh neighborhoods
+    ImplicitChunkStats implicitChunkStats;
+    const WorldGenerator::ColumnExtent& getColumnExtent(int chunkX, int chunkZ);
+    bool hasSavedChunk(const ChunkPos& pos);
+    // Positions without a loaded chunk; columns the frontier hasn't reached are never implicit
+    ImplicitChunk getImplicitChunk(const ChunkPos& pos) const;
+    // Loads an implicit chunk with its (generated) contents; caller holds a ChunkMap::ReadGuard
+    Chunk* materializeChunk(const ChunkPos& pos);
     
     bool isChunkInRange(const ChunkPos& chunkPos, const ChunkPos& centerChunk, int range) const;
+
+    // Neighbors of a chunk (all 26) that have finished generating / are still to be generated
+    // (caller holds a ChunkMap::ReadGuard)
+    void getNeighborGeneration(const ChunkPos& pos, u32& generated, u32& pending) const;
+
+    // Chunks waiting for generating neighbors, with the time they started waiting (seconds)
+    std::unordered_map<ChunkPos, double> meshWaitStart;
+    MeshScheduleStats meshScheduleStats;
 };
@@ -0,0 +1,214 @@
+#include "ChunkMap.h"
+#include <algorithm>
+#include <limits>
+
+namespace {
+// Process-wide epoch domain shared by all chunk maps. A reader publishes the
+// global epoch it entered at; anything retired at an epoch >= the oldest
+// published one may still be referenced and is kept.
+constexpr int MAX_READERS = 128;
+constexpr size_t INITIAL_CAPACITY = 1024;
+
+std::atomic<u64> globalEpoch{1};
+std::atomic<u64> readerEpochs[MAX_READERS];   // 0 = not reading
+std::atomic<bool> readerSlotUsed[MAX_READERS];
+std::atomic<int> overflowReaders{0};          // Readers without a slot block all reclamation
+
+struct ReaderState {
+    int slot = -1;
+    int depth = 0;
+
+    ~ReaderState() {
+        if (slot >= 0) readerSlotUsed[slot].store(false);
+    }
+};
+
+thread_local ReaderState readerState;
+
+// Readers without a slot may have entered at any epoch
+u64 oldestReaderEpoch() {
+    if (overflowReaders.load() > 0) return 0;
+    u64 oldest = std::numeric_limits<u64>::max();
+    for (int i = 0; i < MAX_READERS; ++i) {
+        u64 epoch = readerEpochs[i].load();
+        if (epoch != 0) oldest = std::min(oldest, epoch);
+    }
+    return oldest;
+}
+
+int acquireReaderSlot() {
+    for (int i = 0; i < MAX_READERS; ++i) {
+        bool expected = false;
+        if (!readerSlotUsed[i].load(std::memory_order_relaxed) &&
+            readerSlotUsed[i].compare_exchange_strong(expected, true)) {
+            return i;
+        }
+    }
+    return -1;
+}
+}
+
+ChunkMap::ReadGuard::ReadGuard() {
+    if (readerState.depth++ > 0) return;
+    if (readerState.slot < 0) readerState.slot = acquireReaderSlot();
+
+    if (readerState.slot >= 0) {
+        readerEpochs[readerState.slot].store(globalEpoch.load());
+    } else {
+        overflowReaders.fetch_add(1);
+    }
+}
+
+ChunkMap::ReadGuard::~ReadGuard() {
+    if (--readerState.depth > 0) return;
+
+    if (readerState.slot >= 0) {
+        readerEpochs[readerState.slot].store(0);
+    } else {
+        overflowReaders.fetch_sub(1);
+    }
+}
+
+ChunkMap::Table::Table(size_t capacity)
+    : mask(capacity - 1), slots(std::make_unique<Slot[]>(capacity)) {
+}
+
+ChunkMap::ChunkMap()
+    : ownedTable(std::make_unique<Table>(INITIAL_CAPACITY)) {
+    table.store(ownedTable.get());
+}
+
+ChunkMap::~ChunkMap() = default;
+
+u64 ChunkMap::packKey(const ChunkPos& pos) {
+    // 21 bits per axis plus a marker bit, so no position packs to the empty key
+    constexpr u64 AXIS_MASK = (1ull << 21) - 1;
+    return (1ull << 63) |
+           ((static_cast<u64>(pos.x) & AXIS_MASK) << 42) |
+           ((static_cast<u64>(pos.y) & AXIS_MASK) << 21) |
+           (static_cast<u64>(pos.z) & AXIS_MASK);
+}
+
+size_t ChunkMap::hashKey(u64 key) {
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdull;
+    key ^= key >> 33;
+    return static_cast<size_t>(key);
+}
+
+ChunkMap::Slot* ChunkMap::findSlot(Table& target, u64 key) const {
+    // Tables never fill up (see grow), so every probe ends at an empty slot
+    for (size_t i = hashKey(key) & target.mask;; i = (i + 1) & target.mask) {
+        u64 current = target.slots[i].key.load();
+        if (current == key || current == 0) return &target.slots[i];
+    }
+}
+
+Chunk* ChunkMap::find(const ChunkPos& pos) const {
+    u64 key = packKey(pos);
+    Slot* slot = findSlot(*table.load(), key);
+    // An empty slot may already hold the chunk of an insert that hasn't published its key
+    return slot->key.load() == key ? slot->chunk.load() : nullptr;
+}
+
+std::shared_ptr<Chunk> ChunkMap::get(const ChunkPos& pos) const {
+    ReadGuard guard;
+    Chunk* chunk = find(pos);
+    // Still owned by the map or its retired list while the guard is held
+    return chunk ? chunk->shared_from_this() : nullptr;
+}
+
+bool ChunkMap::insert(const ChunkPos& pos, std::shared_ptr<Chunk> chunk) {
+    std::lock_guard<std::mutex> lock(writeMutex);
+    if (owners.count(pos)) return false;
+
+    Table* current = table.load();
+    if ((current->used + 1) * 4 > (current->mask + 1) * 3) {
+        grow();
+        current = table.load();
+    }
+
+    u64 key = packKey(pos);
+    Slot* slot = findSlot(*current, key);
+    // Chunk before key: a reader that sees the key also sees the chunk
+    slot->chunk.store(chunk.get());
+    if (slot->key.load() == 0) {
+        slot->key.store(key);
+        current->used++;
+    }
+    owners.emplace(pos, std::move(chunk));
+    return true;
+}
+
+bool ChunkMap::erase(const ChunkPos& pos) {
+    std::lock_guard<std::mutex> lock(writeMutex);
+    auto it = owners.find(pos);
+    if (it == owners.end()) return false;
+
+    // The key stays as a tombstone so probes for other positions don't stop early
+    findSlot(*table.load(), packKey(pos))->chunk.store(nullptr);
+    retire(Retired{0, std::move(it->second), nullptr});
+    owners.erase(it);
+    return true;
+}
+
+void ChunkMap::clear() {
+    std::lock_guard<std::mutex> lock(writeMutex);
+    auto fresh = std::make_unique<Table>(INITIAL_CAPACITY);
+    table.store(fresh.get());
+    retire(Retired{0, nullptr, std::move(ownedTable)});
+    ownedTable = std::move(fresh);
+
+    for (auto& [pos, chunk] : owners) {
+        retire(Retired{0, std::move(chunk), nullptr});
+    }
+    owners.clear();
+}
+
+void ChunkMap::grow() {
+    // Sized for the live chunks only, which also drops the tombstones
+    size_t capacity = INITIAL_CAPACITY;
+    while (capacity < (owners.size() + 1) * 4) capacity *= 2;
+
+    auto next = std::make_unique<Table>(capacity);
+    for (const auto& [pos, chunk] : owners) {
+        u64 key = packKey(pos);
+        Slot* slot = findSlot(*next, key);
+        slot->chunk.store(chunk.get());
+        slot->key.store(key);
+        next->used++;
+    }
+
+    table.store(next.get());
+    retire(Retired{0, nullptr, std::move(ownedTable)});
+    ownedTable = std::move(next);
+}
+
+void ChunkMap::retire(Retired entry) {
+    entry.epoch = retireEpoch();
+    retired.push_back(std::move(entry));
+}
+
+u64 ChunkMap::retireEpoch() {
+    // Readers that entered at this epoch or earlier may still hold it
+    return globalEpoch.fetch_add(1);
+}
+
+bool ChunkMap::canReclaim(u64 epoch) {
+    return epoch < oldestReaderEpoch();
+}
+
+void ChunkMap::reclaim() {
+    std::lock_guard<std::mutex> lock(writeMutex);
+    if (retired.empty()) return;
+
+    u64 oldest = oldestReaderEpoch();
+    retired.erase(std::remove_if(retired.begin(), retired.end(),
+                                 [oldest](const Retired& entry) { return entry.epoch < oldest; }),
+                  retired.end());
+}
+
+size_t ChunkMap::getRetiredCount() const {
+    std::lock_guard<std::mutex> lock(writeMutex);
+    return retired.size();
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "../Util/Types.h"
+#include "Chunk.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/gtx/hash.hpp>
+
+// Chunk index with lock-free lookups from any thread.
+//
+// Lookups probe an open-addressed table of { packed position, Chunk* } slots and
+// return a raw pointer: no lock, no shared_ptr refcount traffic. Inserts and
+// erases are serialized by a writer mutex; erased chunks and outgrown tables are
+// retired and only released by reclaim() once no reader that could still see them
+// is active (epoch-based reclamation). A raw pointer is therefore valid for the
+// lifetime of the ReadGuard it was looked up under.
+//
+// items() is the owning map behind the index, for iteration on the thread that
+// inserts/erases (the main thread).
+class ChunkMap {
+public:
+    using Items = std::unordered_map<ChunkPos, std::shared_ptr<Chunk>>;
+
+    // Pins the current epoch for the calling thread; guards nest
+    class ReadGuard {
+    public:
+        ReadGuard();
+        ~ReadGuard();
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+    };
+
+    ChunkMap();
+    ~ChunkMap();
+
+    ChunkMap(const ChunkMap&) = delete;
+    ChunkMap& operator=(const ChunkMap&) = delete;
+
+    // Any thread; the caller must hold a ReadGuard while using the result
+    Chunk* find(const ChunkPos& pos) const;
+    // Any thread; takes its own guard
+    std::shared_ptr<Chunk> get(const ChunkPos& pos) const;
+
+    // Any thread (serialized); false if the position is already taken / not present
+    bool insert(const ChunkPos& pos, std::shared_ptr<Chunk> chunk);
+    bool erase(const ChunkPos& pos);
+    void clear();
+
+    // Releases retired chunks / tables no reader can still reference (call once per frame)
+    void reclaim();
+
+    // The ReadGuard epoch domain, for other lock-free data retired the same way
+    // (Chunk block storages): tag an object when it is unpublished, free it once
+    // canReclaim says no reader that could still see it is left
+    static u64 retireEpoch();
+    static bool canReclaim(u64 epoch);
+
+    const Items& items() const { return owners; }
+    size_t size() const { return owners.size(); }
+    size_t getRetiredCount() const;
+
+private:
+    struct Slot {
+        std::atomic<u64> key{0};          // 0 = empty; never cleared once set (erase leaves a tombstone)
+        std::atomic<Chunk*> chunk{nullptr};
+    };
+
+    struct Table {
+        explicit Table(size_t capacity);
+        size_t mask;
+        size_t used = 0;                  // Slots with a key, tombstones included (writer only)
+        std::unique_ptr<Slot[]> slots;
+    };
+
+    struct Retired {
+        u64 epoch;
+        std::shared_ptr<Chunk> chunk;
+        std::unique_ptr<Table> table;
+    };
+
+    static u64 packKey(const ChunkPos& pos);
+    static size_t hashKey(u64 key);
+
+    Slot* findSlot(Table& table, u64 key) const;  // Slot holding key, or the empty slot ending its probe
+    void grow();                                  // Writer mutex must be held
+    void retire(Retired retired);                 // Writer mutex must be held
+
+    std::atomic<Table*> table;
+    std::unique_ptr<Table> ownedTable;
+    Items owners;
+
+    mutable std::mutex writeMutex;
+    std::vector<Retired> retired;
+};
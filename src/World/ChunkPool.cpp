@@ -0,0 +1,78 @@
+#include "ChunkPool.h"
+#include <algorithm>
+
+ChunkPool::ChunkPool(size_t maxFree)
+    : state(std::make_shared<State>()) {
+    state->maxFree = maxFree;
+}
+
+ChunkPool::~ChunkPool() {
+    std::vector<Chunk*> freeChunks;
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        state->closed = true;
+        freeChunks.swap(state->freeChunks);
+    }
+    for (Chunk* chunk : freeChunks) delete chunk;
+}
+
+std::shared_ptr<Chunk> ChunkPool::acquire(const ChunkPos& pos) {
+    Chunk* chunk = nullptr;
+    u32 slot;
+    u32 generation;
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        Stats& stats = state->stats;
+        stats.acquired++;
+        stats.live++;
+        stats.highWater = std::max(stats.highWater, stats.live);
+
+        if (!state->freeChunks.empty()) {
+            chunk = state->freeChunks.back();
+            state->freeChunks.pop_back();
+            stats.reused++;
+            slot = chunk->handle.slot;
+        } else if (!state->freeSlots.empty()) {
+            slot = state->freeSlots.back();
+            state->freeSlots.pop_back();
+        } else {
+            slot = static_cast<u32>(state->generations.size());
+            state->generations.push_back(0);
+        }
+        generation = ++state->generations[slot];
+    }
+
+    // Nothing references a free chunk, so it can be reset outside the lock
+    if (chunk) chunk->reset(pos);
+    else chunk = new Chunk(pos);
+    chunk->handle = {slot, generation};
+
+    std::shared_ptr<State> owner = state;
+    return std::shared_ptr<Chunk>(chunk, [owner](Chunk* released) { release(owner, released); });
+}
+
+void ChunkPool::release(const std::shared_ptr<State>& state, Chunk* chunk) {
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        if (!state->closed) {
+            state->stats.live--;
+            if (state->freeChunks.size() < state->maxFree) {
+                state->freeChunks.push_back(chunk);
+                return;
+            }
+            state->freeSlots.push_back(chunk->handle.slot);
+        }
+    }
+    delete chunk;
+}
+
+ChunkPool::Stats ChunkPool::getStats() const {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    Stats result = state->stats;
+    result.free = state->freeChunks.size();
+    // Nothing else references a free chunk
+    for (const Chunk* chunk : state->freeChunks) {
+        result.freeBytes += sizeof(Chunk) + chunk->getMemoryUsage();
+    }
+    return result;
+}
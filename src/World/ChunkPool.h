@@ -0,0 +1,54 @@
+#pragma once
+
+#include "../Util/Types.h"
+#include "../Util/Config.h"
+#include "Chunk.h"
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Recycles Chunk objects across unload / load. acquire() hands out a shared_ptr whose
+// deleter returns the chunk once its last reference is gone (ChunkMap's retired list,
+// a job, a mesh neighborhood); a later acquire reuses it together with its block
+// storages and mip arrays, and starts it as uniform air instead of clearing blocks.
+//
+// Every chunk handed out carries a ChunkHandle whose generation is new for each acquire,
+// so a handle kept instead of a reference tells whether the chunk now found at a
+// position (possibly the same object, recycled) is still the one it was taken from.
+class ChunkPool {
+public:
+    struct Stats {
+        size_t live = 0;        // Chunks handed out and not released yet
+        size_t free = 0;        // Released chunks waiting for reuse
+        size_t freeBytes = 0;   // Held by those: chunk objects, their storages and mip arrays
+        size_t highWater = 0;   // Most chunks live at once
+        u64 acquired = 0;
+        u64 reused = 0;         // Acquires served from the free list
+    };
+
+    explicit ChunkPool(size_t maxFree = CHUNK_POOL_MAX_FREE);
+    ~ChunkPool();
+
+    ChunkPool(const ChunkPool&) = delete;
+    ChunkPool& operator=(const ChunkPool&) = delete;
+
+    // Any thread
+    std::shared_ptr<Chunk> acquire(const ChunkPos& pos);
+    Stats getStats() const;
+
+private:
+    // Shared with the deleters, so chunks released after the pool is gone are just freed
+    struct State {
+        std::mutex mutex;
+        std::vector<u32> generations;   // Per slot, counts its acquires
+        std::vector<u32> freeSlots;     // Slots whose chunk was deleted
+        std::vector<Chunk*> freeChunks;
+        size_t maxFree = 0;
+        bool closed = false;
+        Stats stats;
+    };
+
+    static void release(const std::shared_ptr<State>& state, Chunk* chunk);
+
+    std::shared_ptr<State> state;
+};
@@ -0,0 +1,58 @@
+#include "ColumnCache.h"
+
+ColumnCache::ColumnCache(size_t capacity) : capacity(capacity > 0 ? capacity : 1) {
+}
+
+std::shared_ptr<const ColumnData> ColumnCache::find(int chunkX, int chunkZ) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = entries.find(makeKey(chunkX, chunkZ));
+    if (it == entries.end()) {
+        misses++;
+        return nullptr;
+    }
+
+    // Move to front of LRU list
+    lru.splice(lru.begin(), lru, it->second.lruIt);
+    hits++;
+    return it->second.data;
+}
+
+std::shared_ptr<const ColumnData> ColumnCache::insert(int chunkX, int chunkZ, std::shared_ptr<const ColumnData> data) {
+    std::lock_guard<std::mutex> lock(mutex);
+    Key key = makeKey(chunkX, chunkZ);
+
+    auto it = entries.find(key);
+    if (it != entries.end()) {
+        // Keep a stale entry only if the incoming one isn't newer (seed change)
+        if (it->second.data->seed == data->seed) {
+            lru.splice(lru.begin(), lru, it->second.lruIt);
+            return it->second.data;
+        }
+        it->second.data = std::move(data);
+        lru.splice(lru.begin(), lru, it->second.lruIt);
+        return it->second.data;
+    }
+
+    // Evict least recently used columns
+    while (entries.size() >= capacity && !lru.empty()) {
+        entries.erase(lru.back());
+        lru.pop_back();
+    }
+
+    lru.push_front(key);
+    auto& entry = entries[key];
+    entry.data = std::move(data);
+    entry.lruIt = lru.begin();
+    return entry.data;
+}
+
+void ColumnCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+    lru.clear();
+}
+
+size_t ColumnCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+}
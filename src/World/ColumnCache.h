@@ -0,0 +1,74 @@
+#pragma once
+
+#include "../Util/Types.h"
+#include "../Util/Config.h"
+#include "WorldGenerator.h"
+#include <array>
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+// Tree that touches a chunk column (trunk may be in a neighbouring column)
+struct TreeCandidate {
+    int worldX;
+    int worldZ;
+    int baseY;   // First trunk block (surface height)
+    int height;  // Trunk height
+};
+
+// Per-column terrain data shared by every vertical chunk of a (chunkX, chunkZ) column
+struct ColumnData {
+    unsigned int seed = 0; // Seed the data was generated with
+    std::array<int, CHUNK_AREA> surfaceHeight;
+    std::array<BiomeType, CHUNK_AREA> biome;
+    std::array<float, CHUNK_AREA> temperature;
+    std::vector<TreeCandidate> trees;
+    int minHeight = 0;
+    int maxHeight = 0;
+
+    static int index(int x, int z) { return z * CHUNK_SIZE + x; }
+};
+
+// Thread-safe LRU cache of ColumnData keyed by chunk column
+class ColumnCache {
+public:
+    explicit ColumnCache(size_t capacity = COLUMN_CACHE_SIZE);
+    ~ColumnCache() = default;
+
+    // Returns nullptr on miss
+    std::shared_ptr<const ColumnData> find(int chunkX, int chunkZ);
+
+    // Inserts data for a column. If another thread already inserted the same column,
+    // the existing entry wins and is returned so all chunks share one copy.
+    std::shared_ptr<const ColumnData> insert(int chunkX, int chunkZ, std::shared_ptr<const ColumnData> data);
+
+    void clear();
+
+    size_t size() const;
+    size_t getCapacity() const { return capacity; }
+    u64 getHits() const { return hits.load(); }
+    u64 getMisses() const { return misses.load(); }
+
+private:
+    using Key = u64;
+
+    struct Entry {
+        std::shared_ptr<const ColumnData> data;
+        std::list<Key>::iterator lruIt;
+    };
+
+    static Key makeKey(int chunkX, int chunkZ) {
+        return (static_cast<u64>(static_cast<u32>(chunkX)) << 32) | static_cast<u32>(chunkZ);
+    }
+
+    mutable std::mutex mutex;
+    std::list<Key> lru; // Front = most recently used
+    std::unordered_map<Key, Entry> entries;
+    size_t capacity;
+
+    std::atomic<u64> hits{0};
+    std::atomic<u64> misses{0};
+};
@@ -0,0 +1,321 @@
+#include "NoiseKernels.h"
+#include <atomic>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define NOISE_KERNELS_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define NOISE_TARGET_SSE41
+#define NOISE_TARGET_AVX2
+#else
+#define NOISE_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define NOISE_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace {
+
+using BatchFn3D = void (*)(unsigned int, const float*, const float*, const float*, float*, int);
+
+void noise3DScalar(unsigned int seed, const float* x, const float* y, const float* z, float* out, int count) {
+    for (int i = 0; i < count; ++i) {
+        out[i] = NoiseKernels::noise3D(seed, x[i], y[i], z[i]);
+    }
+}
+
+#ifdef NOISE_KERNELS_X86
+
+// ---------------------------------------------------------------------------
+// SSE4.1 (4 lanes)
+// Each helper mirrors the scalar operation order exactly (no FMA contraction),
+// so results are bit-identical to NoiseKernels::noise3D.
+// ---------------------------------------------------------------------------
+
+NOISE_TARGET_SSE41 inline __m128i hash4(__m128i seed, __m128i i, __m128i j, __m128i k) {
+    __m128i h = seed;
+    h = _mm_xor_si128(h, _mm_mullo_epi32(i, _mm_set1_epi32(374761393)));
+    h = _mm_xor_si128(h, _mm_mullo_epi32(j, _mm_set1_epi32(668265263)));
+    h = _mm_xor_si128(h, _mm_mullo_epi32(k, _mm_set1_epi32(1274126177)));
+    h = _mm_xor_si128(h, _mm_srli_epi32(h, 13));
+    h = _mm_mullo_epi32(h, _mm_set1_epi32(0x5bd1e995));
+    h = _mm_xor_si128(h, _mm_srli_epi32(h, 15));
+    return h; // Only the low 4 bits are consumed by grad4
+}
+
+NOISE_TARGET_SSE41 inline __m128 grad4(__m128i hash, __m128 x, __m128 y, __m128 z) {
+    __m128i h = _mm_and_si128(hash, _mm_set1_epi32(15));
+
+    __m128 uIsX = _mm_castsi128_ps(_mm_cmplt_epi32(h, _mm_set1_epi32(8)));
+    __m128 u = _mm_blendv_ps(y, x, uIsX);
+
+    __m128 vIsY = _mm_castsi128_ps(_mm_cmplt_epi32(h, _mm_set1_epi32(4)));
+    __m128 vIsX = _mm_castsi128_ps(_mm_or_si128(_mm_cmpeq_epi32(h, _mm_set1_epi32(12)),
+                                                _mm_cmpeq_epi32(h, _mm_set1_epi32(14))));
+    __m128 v = _mm_blendv_ps(_mm_blendv_ps(z, x, vIsX), y, vIsY);
+
+    // Negation is a sign-bit flip, exactly like unary minus
+    __m128 signU = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(1)), 31));
+    __m128 signV = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(2)), 30));
+    return _mm_add_ps(_mm_xor_ps(u, signU), _mm_xor_ps(v, signV));
+}
+
+NOISE_TARGET_SSE41 inline __m128 fade4(__m128 t) {
+    __m128 inner = _mm_add_ps(_mm_mul_ps(t, _mm_sub_ps(_mm_mul_ps(t, _mm_set1_ps(6.0f)), _mm_set1_ps(15.0f))),
+                              _mm_set1_ps(10.0f));
+    return _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(t, t), t), inner);
+}
+
+NOISE_TARGET_SSE41 inline __m128 lerp4(__m128 a, __m128 b, __m128 t) {
+    return _mm_add_ps(a, _mm_mul_ps(t, _mm_sub_ps(b, a)));
+}
+
+NOISE_TARGET_SSE41 void noise3DSSE41(unsigned int seed, const float* x, const float* y, const float* z, float* out, int count) {
+    const __m128i seedV = _mm_set1_epi32(static_cast<int>(seed));
+    const __m128i mask = _mm_set1_epi32(255);
+    const __m128i one = _mm_set1_epi32(1);
+    const __m128 onef = _mm_set1_ps(1.0f);
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 px = _mm_loadu_ps(x + i);
+        __m128 py = _mm_loadu_ps(y + i);
+        __m128 pz = _mm_loadu_ps(z + i);
+
+        __m128 fx = _mm_floor_ps(px);
+        __m128 fy = _mm_floor_ps(py);
+        __m128 fz = _mm_floor_ps(pz);
+
+        __m128i xi = _mm_and_si128(_mm_cvttps_epi32(fx), mask);
+        __m128i yi = _mm_and_si128(_mm_cvttps_epi32(fy), mask);
+        __m128i zi = _mm_and_si128(_mm_cvttps_epi32(fz), mask);
+        __m128i xi1 = _mm_add_epi32(xi, one);
+        __m128i yi1 = _mm_add_epi32(yi, one);
+        __m128i zi1 = _mm_add_epi32(zi, one);
+
+        __m128 xf = _mm_sub_ps(px, fx);
+        __m128 yf = _mm_sub_ps(py, fy);
+        __m128 zf = _mm_sub_ps(pz, fz);
+        __m128 xf1 = _mm_sub_ps(xf, onef);
+        __m128 yf1 = _mm_sub_ps(yf, onef);
+        __m128 zf1 = _mm_sub_ps(zf, onef);
+
+        __m128 u = fade4(xf);
+        __m128 v = fade4(yf);
+        __m128 w = fade4(zf);
+
+        __m128 val_aaa = grad4(hash4(seedV, xi, yi, zi), xf, yf, zf);
+        __m128 val_aba = grad4(hash4(seedV, xi, yi1, zi), xf, yf1, zf);
+        __m128 val_aab = grad4(hash4(seedV, xi, yi, zi1), xf, yf, zf1);
+        __m128 val_abb = grad4(hash4(seedV, xi, yi1, zi1), xf, yf1, zf1);
+        __m128 val_baa = grad4(hash4(seedV, xi1, yi, zi), xf1, yf, zf);
+        __m128 val_bba = grad4(hash4(seedV, xi1, yi1, zi), xf1, yf1, zf);
+        __m128 val_bab = grad4(hash4(seedV, xi1, yi, zi1), xf1, yf, zf1);
+        __m128 val_bbb = grad4(hash4(seedV, xi1, yi1, zi1), xf1, yf1, zf1);
+
+        __m128 x1 = lerp4(val_aaa, val_baa, u);
+        __m128 x2 = lerp4(val_aba, val_bba, u);
+        __m128 x3 = lerp4(val_aab, val_bab, u);
+        __m128 x4 = lerp4(val_abb, val_bbb, u);
+
+        __m128 y1 = lerp4(x1, x2, v);
+        __m128 y2 = lerp4(x3, x4, v);
+
+        _mm_storeu_ps(out + i, lerp4(y1, y2, w));
+    }
+
+    noise3DScalar(seed, x + i, y + i, z + i, out + i, count - i);
+}
+
+// ---------------------------------------------------------------------------
+// AVX2 (8 lanes)
+// ---------------------------------------------------------------------------
+
+NOISE_TARGET_AVX2 inline __m256i hash8(__m256i seed, __m256i i, __m256i j, __m256i k) {
+    __m256i h = seed;
+    h = _mm256_xor_si256(h, _mm256_mullo_epi32(i, _mm256_set1_epi32(374761393)));
+    h = _mm256_xor_si256(h, _mm256_mullo_epi32(j, _mm256_set1_epi32(668265263)));
+    h = _mm256_xor_si256(h, _mm256_mullo_epi32(k, _mm256_set1_epi32(1274126177)));
+    h = _mm256_xor_si256(h, _mm256_srli_epi32(h, 13));
+    h = _mm256_mullo_epi32(h, _mm256_set1_epi32(0x5bd1e995));
+    h = _mm256_xor_si256(h, _mm256_srli_epi32(h, 15));
+    return h;
+}
+
+NOISE_TARGET_AVX2 inline __m256 grad8(__m256i hash, __m256 x, __m256 y, __m256 z) {
+    __m256i h = _mm256_and_si256(hash, _mm256_set1_epi32(15));
+
+    __m256 uIsX = _mm256_castsi256_ps(_mm256_cmpgt_epi32(_mm256_set1_epi32(8), h));
+    __m256 u = _mm256_blendv_ps(y, x, uIsX);
+
+    __m256 vIsY = _mm256_castsi256_ps(_mm256_cmpgt_epi32(_mm256_set1_epi32(4), h));
+    __m256 vIsX = _mm256_castsi256_ps(_mm256_or_si256(_mm256_cmpeq_epi32(h, _mm256_set1_epi32(12)),
+                                                      _mm256_cmpeq_epi32(h, _mm256_set1_epi32(14))));
+    __m256 v = _mm256_blendv_ps(_mm256_blendv_ps(z, x, vIsX), y, vIsY);
+
+    __m256 signU = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(h, _mm256_set1_epi32(1)), 31));
+    __m256 signV = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(h, _mm256_set1_epi32(2)), 30));
+    return _mm256_add_ps(_mm256_xor_ps(u, signU), _mm256_xor_ps(v, signV));
+}
+
+NOISE_TARGET_AVX2 inline __m256 fade8(__m256 t) {
+    __m256 inner = _mm256_add_ps(_mm256_mul_ps(t, _mm256_sub_ps(_mm256_mul_ps(t, _mm256_set1_ps(6.0f)), _mm256_set1_ps(15.0f))),
+                                 _mm256_set1_ps(10.0f));
+    return _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(t, t), t), inner);
+}
+
+NOISE_TARGET_AVX2 inline __m256 lerp8(__m256 a, __m256 b, __m256 t) {
+    return _mm256_add_ps(a, _mm256_mul_ps(t, _mm256_sub_ps(b, a)));
+}
+
+NOISE_TARGET_AVX2 void noise3DAVX2(unsigned int seed, const float* x, const float* y, const float* z, float* out, int count) {
+    const __m256i seedV = _mm256_set1_epi32(static_cast<int>(seed));
+    const __m256i mask = _mm256_set1_epi32(255);
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256 onef = _mm256_set1_ps(1.0f);
+
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 px = _mm256_loadu_ps(x + i);
+        __m256 py = _mm256_loadu_ps(y + i);
+        __m256 pz = _mm256_loadu_ps(z + i);
+
+        __m256 fx = _mm256_floor_ps(px);
+        __m256 fy = _mm256_floor_ps(py);
+        __m256 fz = _mm256_floor_ps(pz);
+
+        __m256i xi = _mm256_and_si256(_mm256_cvttps_epi32(fx), mask);
+        __m256i yi = _mm256_and_si256(_mm256_cvttps_epi32(fy), mask);
+        __m256i zi = _mm256_and_si256(_mm256_cvttps_epi32(fz), mask);
+        __m256i xi1 = _mm256_add_epi32(xi, one);
+        __m256i yi1 = _mm256_add_epi32(yi, one);
+        __m256i zi1 = _mm256_add_epi32(zi, one);
+
+        __m256 xf = _mm256_sub_ps(px, fx);
+        __m256 yf = _mm256_sub_ps(py, fy);
+        __m256 zf = _mm256_sub_ps(pz, fz);
+        __m256 xf1 = _mm256_sub_ps(xf, onef);
+        __m256 yf1 = _mm256_sub_ps(yf, onef);
+        __m256 zf1 = _mm256_sub_ps(zf, onef);
+
+        __m256 u = fade8(xf);
+        __m256 v = fade8(yf);
+        __m256 w = fade8(zf);
+
+        __m256 val_aaa = grad8(hash8(seedV, xi, yi, zi), xf, yf, zf);
+        __m256 val_aba = grad8(hash8(seedV, xi, yi1, zi), xf, yf1, zf);
+        __m256 val_aab = grad8(hash8(seedV, xi, yi, zi1), xf, yf, zf1);
+        __m256 val_abb = grad8(hash8(seedV, xi, yi1, zi1), xf, yf1, zf1);
+        __m256 val_baa = grad8(hash8(seedV, xi1, yi, zi), xf1, yf, zf);
+        __m256 val_bba = grad8(hash8(seedV, xi1, yi1, zi), xf1, yf1, zf);
+        __m256 val_bab = grad8(hash8(seedV, xi1, yi, zi1), xf1, yf, zf1);
+        __m256 val_bbb = grad8(hash8(seedV, xi1, yi1, zi1), xf1, yf1, zf1);
+
+        __m256 x1 = lerp8(val_aaa, val_baa, u);
+        __m256 x2 = lerp8(val_aba, val_bba, u);
+        __m256 x3 = lerp8(val_aab, val_bab, u);
+        __m256 x4 = lerp8(val_abb, val_bbb, u);
+
+        __m256 y1 = lerp8(x1, x2, v);
+        __m256 y2 = lerp8(x3, x4, v);
+
+        _mm256_storeu_ps(out + i, lerp8(y1, y2, w));
+    }
+
+    noise3DScalar(seed, x + i, y + i, z + i, out + i, count - i);
+}
+
+bool cpuSupports(NoiseKernels::Backend backend) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    int maxLeaf = info[0];
+    if (maxLeaf < 1) return false;
+
+    __cpuid(info, 1);
+    bool sse41 = (info[2] & (1 << 19)) != 0;
+    if (backend == NoiseKernels::Backend::SSE41) return sse41;
+
+    // AVX2 also needs the OS to save YMM state
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || maxLeaf < 7) return false;
+    if ((_xgetbv(0) & 0x6) != 0x6) return false;
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    if (backend == NoiseKernels::Backend::SSE41) return __builtin_cpu_supports("sse4.1");
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#endif // NOISE_KERNELS_X86
+
+std::atomic<int> activeBackend{-1};
+
+BatchFn3D selectKernel(NoiseKernels::Backend backend) {
+#ifdef NOISE_KERNELS_X86
+    switch (backend) {
+        case NoiseKernels::Backend::AVX2: return noise3DAVX2;
+        case NoiseKernels::Backend::SSE41: return noise3DSSE41;
+        default: break;
+    }
+#else
+    (void)backend;
+#endif
+    return noise3DScalar;
+}
+
+} // namespace
+
+NoiseKernels::Backend NoiseKernels::getBestSupportedBackend() {
+#ifdef NOISE_KERNELS_X86
+    static const Backend best = cpuSupports(Backend::AVX2) ? Backend::AVX2
+                              : cpuSupports(Backend::SSE41) ? Backend::SSE41
+                              : Backend::SCALAR;
+    return best;
+#else
+    return Backend::SCALAR;
+#endif
+}
+
+NoiseKernels::Backend NoiseKernels::getBackend() {
+    int current = activeBackend.load(std::memory_order_relaxed);
+    if (current < 0) {
+        current = static_cast<int>(getBestSupportedBackend());
+        activeBackend.store(current, std::memory_order_relaxed);
+    }
+    return static_cast<Backend>(current);
+}
+
+void NoiseKernels::setBackend(Backend backend) {
+    if (static_cast<int>(backend) > static_cast<int>(getBestSupportedBackend())) {
+        backend = getBestSupportedBackend();
+    }
+    activeBackend.store(static_cast<int>(backend), std::memory_order_relaxed);
+}
+
+const char* NoiseKernels::getBackendName(Backend backend) {
+    switch (backend) {
+        case Backend::SCALAR: return "Scalar";
+        case Backend::SSE41: return "SSE4.1";
+        case Backend::AVX2: return "AVX2";
+        default: return "Unknown";
+    }
+}
+
+void NoiseKernels::noise3D(unsigned int seed, const float* x, const float* y, const float* z, float* out, int count) {
+    selectKernel(getBackend())(seed, x, y, z, out, count);
+}
+
+void NoiseKernels::noise2D(unsigned int seed, const float* x, const float* z, float* out, int count) {
+    // noise2D is the y = 0 slice of noise3D; evaluate in blocks against a shared zero row
+    constexpr int BLOCK = 256;
+    static const float zeros[BLOCK] = {};
+    BatchFn3D kernel = selectKernel(getBackend());
+    for (int i = 0; i < count; i += BLOCK) {
+        int n = (count - i < BLOCK) ? count - i : BLOCK;
+        kernel(seed, x + i, zeros, z + i, out + i, n);
+    }
+}
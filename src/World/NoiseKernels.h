@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cmath>
+
+// Gradient noise kernels used by WorldGenerator.
+// The batch entry points evaluate many samples per call using the widest
+// instruction set available at runtime (AVX2 -> SSE4.1 -> scalar). Every
+// backend produces bit-identical results to the scalar noise3D() below.
+class NoiseKernels {
+public:
+    enum class Backend {
+        SCALAR,
+        SSE41,
+        AVX2
+    };
+
+    // Backend picked from CPU features on first use
+    static Backend getBackend();
+    // Force a backend (e.g. SCALAR for comparisons). Falls back to the best
+    // supported backend if the requested one isn't available on this CPU.
+    static void setBackend(Backend backend);
+    static Backend getBestSupportedBackend();
+    static const char* getBackendName(Backend backend);
+
+    // Single sample reference implementation (Improved Perlin gradient noise)
+    static float noise3D(unsigned int seed, float x, float y, float z) {
+        float fx = std::floor(x);
+        float fy = std::floor(y);
+        float fz = std::floor(z);
+
+        int xi = static_cast<int>(fx) & 255;
+        int yi = static_cast<int>(fy) & 255;
+        int zi = static_cast<int>(fz) & 255;
+
+        float xf = x - fx;
+        float yf = y - fy;
+        float zf = z - fz;
+
+        float u = fade(xf);
+        float v = fade(yf);
+        float w = fade(zf);
+
+        int aaa = hash(seed, xi, yi, zi);
+        int aba = hash(seed, xi, yi + 1, zi);
+        int aab = hash(seed, xi, yi, zi + 1);
+        int abb = hash(seed, xi, yi + 1, zi + 1);
+        int baa = hash(seed, xi + 1, yi, zi);
+        int bba = hash(seed, xi + 1, yi + 1, zi);
+        int bab = hash(seed, xi + 1, yi, zi + 1);
+        int bbb = hash(seed, xi + 1, yi + 1, zi + 1);
+
+        // Calculate dot products
+        float val_aaa = grad(aaa, xf, yf, zf);
+        float val_aba = grad(aba, xf, yf - 1, zf);
+        float val_aab = grad(aab, xf, yf, zf - 1);
+        float val_abb = grad(abb, xf, yf - 1, zf - 1);
+        float val_baa = grad(baa, xf - 1, yf, zf);
+        float val_bba = grad(bba, xf - 1, yf - 1, zf);
+        float val_bab = grad(bab, xf - 1, yf, zf - 1);
+        float val_bbb = grad(bbb, xf - 1, yf - 1, zf - 1);
+
+        // Trilinear interpolation
+        float x1 = lerp(val_aaa, val_baa, u);
+        float x2 = lerp(val_aba, val_bba, u);
+        float x3 = lerp(val_aab, val_bab, u);
+        float x4 = lerp(val_abb, val_bbb, u);
+
+        float y1 = lerp(x1, x2, v);
+        float y2 = lerp(x3, x4, v);
+
+        return lerp(y1, y2, w);
+    }
+
+    // Batch evaluation: out[i] = noise3D(seed, x[i], y[i], z[i])
+    static void noise3D(unsigned int seed, const float* x, const float* y, const float* z, float* out, int count);
+    // Batch evaluation: out[i] = noise3D(seed, x[i], 0, z[i])
+    static void noise2D(unsigned int seed, const float* x, const float* z, float* out, int count);
+
+    // Hash function with better mixing
+    static int hash(unsigned int seed, int i, int j, int k) {
+        unsigned int h = seed;
+        h ^= static_cast<unsigned int>(i) * 374761393u;
+        h ^= static_cast<unsigned int>(j) * 668265263u;
+        h ^= static_cast<unsigned int>(k) * 1274126177u;
+        h ^= h >> 13;
+        h *= 0x5bd1e995u;
+        h ^= h >> 15;
+        return static_cast<int>(h & 0xFFFFFF);
+    }
+
+    static float grad(int hash, float x, float y, float z) {
+        // Convert low 4 bits of hash code into 12 gradient directions
+        int h = hash & 15;
+        float u = h < 8 ? x : y;
+        float v = h < 4 ? y : h == 12 || h == 14 ? x : z;
+        return ((h & 1) == 0 ? u : -u) + ((h & 2) == 0 ? v : -v);
+    }
+
+    static float fade(float t) {
+        // Quintic interpolation for smoother gradients
+        return t * t * t * (t * (t * 6.0f - 15.0f) + 10.0f);
+    }
+
+    static float lerp(float a, float b, float t) {
+        return a + t * (b - a);
+    }
+};
@@ -0,0 +1,382 @@
+#include "RegionFile.h"
+#include "../Core/Logger.h"
+#include <algorithm>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+namespace {
+int floorDiv(int a, int b) {
+    return (a >= 0) ? a / b : -((-a + b - 1) / b);
+}
+}
+
+RegionFile::RegionFile(const std::string& path)
+    : path(path), journalPath(path + ".journal"), table(REGION_VOLUME) {
+}
+
+int RegionFile::localIndex(const ChunkPos& pos) {
+    glm::ivec3 region = regionOf(pos);
+    int lx = pos.x - region.x * REGION_SIZE;
+    int ly = pos.y - region.y * REGION_SIZE;
+    int lz = pos.z - region.z * REGION_SIZE;
+    return (ly * REGION_SIZE + lz) * REGION_SIZE + lx;
+}
+
+glm::ivec3 RegionFile::regionOf(const ChunkPos& pos) {
+    return glm::ivec3(floorDiv(pos.x, REGION_SIZE), floorDiv(pos.y, REGION_SIZE), floorDiv(pos.z, REGION_SIZE));
+}
+
+bool RegionFile::open() {
+    file.close();
+    std::fill(table.begin(), table.end(), Entry{});
+    usedSectors.clear();
+    freeSectors = 0;
+    if (!fs::exists(path)) return false;
+
+    file.open(path, std::ios::in | std::ios::out | std::ios::binary);
+    if (!file.is_open()) {
+        LOG_ERROR("Failed to open region file " + path);
+        return false;
+    }
+
+    u32 magic = 0;
+    u32 version = 0;
+    file.read(reinterpret_cast<char*>(&magic), sizeof(u32));
+    file.read(reinterpret_cast<char*>(&version), sizeof(u32));
+    file.read(reinterpret_cast<char*>(table.data()), REGION_VOLUME * sizeof(Entry));
+    if (!file || magic != MAGIC || (version != 1 && version != VERSION)) {
+        LOG_ERROR("Invalid region file " + path);
+        std::fill(table.begin(), table.end(), Entry{});
+        file.close();
+        return false;
+    }
+
+    sectorSize = version == 1 ? V1_SECTOR_SIZE : REGION_SECTOR_SIZE;
+    headerSectors = sectorsFor(HEADER_BYTES, sectorSize);
+    if (!replayJournal()) {
+        LOG_ERROR("Failed to apply the journal of region file " + path);
+    }
+
+    u64 size = fs::file_size(path);
+    u64 sectorCount = (size + sectorSize - 1) / sectorSize;
+
+    // Drop entries pointing outside the file
+    for (Entry& entry : table) {
+        if (entry.sector == 0) continue;
+        if (entry.sector < headerSectors || entry.sector + sectorsFor(entry.length, sectorSize) > sectorCount) {
+            entry = Entry{};
+        }
+    }
+
+    usedSectors.assign(sectorCount, false);
+    freeSectors = static_cast<u32>(sectorCount);
+    for (u32 i = 0; i < headerSectors && i < sectorCount; ++i) {
+        usedSectors[i] = true;
+        freeSectors--;
+    }
+    for (const Entry& entry : table) {
+        markSectors(entry, true);
+    }
+    return true;
+}
+
+bool RegionFile::read(int index, std::vector<u8>& out) {
+    const Entry& entry = table[index];
+    if (entry.sector == 0) return false;
+
+    out.resize(entry.length);
+    file.clear();
+    file.seekg(static_cast<std::streamoff>(entry.sector) * sectorSize);
+    file.read(reinterpret_cast<char*>(out.data()), entry.length);
+    if (!file) {
+        LOG_ERROR("Failed to read chunk from region file " + path);
+        return false;
+    }
+    return true;
+}
+
+bool RegionFile::write(const std::vector<std::pair<int, const std::vector<u8>*>>& updates) {
+    // A new (or unreadable) region starts out compacted
+    if (!file.is_open()) return compact(updates);
+
+    // Payloads first, into sectors no current offset points at
+    static const char zeros[V1_SECTOR_SIZE] = {};
+    std::vector<JournalRecord> records;
+    records.reserve(updates.size());
+    for (const auto& [index, payload] : updates) {
+        Entry entry;
+        if (!payload->empty()) {
+            entry.length = static_cast<u32>(payload->size());
+            u32 sectors = sectorsFor(entry.length, sectorSize);
+            entry.sector = allocate(sectors);
+            markSectors(entry, true);
+            file.clear();
+            file.seekp(static_cast<std::streamoff>(entry.sector) * sectorSize);
+            file.write(reinterpret_cast<const char*>(payload->data()), entry.length);
+            file.write(zeros, sectors * sectorSize - entry.length);
+        }
+        records.push_back(JournalRecord{static_cast<u32>(index), entry});
+    }
+    file.flush();
+
+    if (!file || !writeJournal(records)) {
+        LOG_ERROR("Failed to write chunks to region file " + path);
+        for (const JournalRecord& record : records) markSectors(record.entry, false);
+        return false;
+    }
+
+    // Committed: the offsets can be patched into the header
+    std::vector<Entry> previous;
+    previous.reserve(records.size());
+    for (const JournalRecord& record : records) previous.push_back(table[record.index]);
+    if (!writeEntries(records)) {
+        // The journal still holds the whole batch, reopening replays it
+        LOG_ERROR("Failed to update the offsets of region file " + path);
+        open();
+        return false;
+    }
+    std::error_code ec;
+    fs::remove(journalPath, ec);
+    for (const Entry& entry : previous) markSectors(entry, false);
+
+    u32 dataSectors = static_cast<u32>(usedSectors.size()) - headerSectors;
+    if (freeSectors >= static_cast<u32>(REGION_COMPACT_MIN_SECTORS) &&
+        freeSectors > dataSectors * REGION_COMPACT_FREE_RATIO) {
+        compact({}); // The batch is stored either way
+    }
+    return true;
+}
+
+u32 RegionFile::checksum(const std::vector<JournalRecord>& records) {
+    // FNV-1a
+    u32 hash = 2166136261u;
+    const u8* bytes = reinterpret_cast<const u8*>(records.data());
+    for (size_t i = 0; i < records.size() * sizeof(JournalRecord); ++i) {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash;
+}
+
+bool RegionFile::writeJournal(const std::vector<JournalRecord>& records) {
+    std::ofstream out(journalPath, std::ios::binary | std::ios::trunc);
+    u32 count = static_cast<u32>(records.size());
+    u32 sum = checksum(records);
+    out.write(reinterpret_cast<const char*>(&JOURNAL_MAGIC), sizeof(u32));
+    out.write(reinterpret_cast<const char*>(&count), sizeof(u32));
+    out.write(reinterpret_cast<const char*>(records.data()), count * sizeof(JournalRecord));
+    out.write(reinterpret_cast<const char*>(&sum), sizeof(u32));
+    out.close();
+    return static_cast<bool>(out);
+}
+
+bool RegionFile::replayJournal() {
+    if (!fs::exists(journalPath)) return true;
+
+    std::vector<JournalRecord> records;
+    bool complete = false;
+    {
+        std::ifstream in(journalPath, std::ios::binary);
+        u32 magic = 0;
+        u32 count = 0;
+        in.read(reinterpret_cast<char*>(&magic), sizeof(u32));
+        in.read(reinterpret_cast<char*>(&count), sizeof(u32));
+        if (in && magic == JOURNAL_MAGIC && count <= static_cast<u32>(REGION_VOLUME)) {
+            records.resize(count);
+            u32 sum = 0;
+            in.read(reinterpret_cast<char*>(records.data()), count * sizeof(JournalRecord));
+            in.read(reinterpret_cast<char*>(&sum), sizeof(u32));
+            complete = in && sum == checksum(records) &&
+                       std::all_of(records.begin(), records.end(),
+                                   [](const JournalRecord& record) { return record.index < static_cast<u32>(REGION_VOLUME); });
+        }
+    }
+
+    // An incomplete journal is a batch that never committed; its payloads are just free sectors
+    if (complete) {
+        if (!writeEntries(records)) return false;
+        LOG_INFO("Recovered " + std::to_string(records.size()) + " chunk offsets of region file " + path);
+    }
+    std::error_code ec;
+    fs::remove(journalPath, ec);
+    return true;
+}
+
+bool RegionFile::writeEntries(const std::vector<JournalRecord>& records) {
+    for (const JournalRecord& record : records) {
+        table[record.index] = record.entry;
+        file.clear();
+        file.seekp(8 + static_cast<std::streamoff>(record.index) * sizeof(Entry));
+        file.write(reinterpret_cast<const char*>(&record.entry), sizeof(Entry));
+    }
+    file.flush();
+    return static_cast<bool>(file);
+}
+
+u32 RegionFile::allocate(u32 sectors) {
+    u32 run = 0;
+    u32 end = static_cast<u32>(usedSectors.size());
+    if (freeSectors >= sectors) {
+        for (u32 i = headerSectors; i < end; ++i) {
+            run = usedSectors[i] ? 0 : run + 1;
+            if (run == sectors) return i + 1 - sectors;
+        }
+    } else {
+        while (run < end - headerSectors && !usedSectors[end - 1 - run]) run++;
+    }
+    // Free sectors at the end of the file are extended
+    return end - run;
+}
+
+void RegionFile::markSectors(const Entry& entry, bool used) {
+    if (entry.sector == 0) return;
+    u32 end = entry.sector + sectorsFor(entry.length, sectorSize);
+    while (usedSectors.size() < end) {
+        usedSectors.push_back(false);
+        freeSectors++;
+    }
+    for (u32 i = entry.sector; i < end; ++i) {
+        if (usedSectors[i] == used) continue;
+        usedSectors[i] = used;
+        if (used) freeSectors--;
+        else freeSectors++;
+    }
+}
+
+bool RegionFile::compact(const std::vector<std::pair<int, const std::vector<u8>*>>& updates) {
+
+    std::vector<const std::vector<u8>*> replaced(REGION_VOLUME, nullptr);
+    for (const auto& [index, payload] : updates) {
+        replaced[index] = payload;
+    }
+
+    std::string tempPath = path + ".tmp";
+    std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        LOG_ERROR("Failed to create " + tempPath);
+        return false;
+    }
+
+    // Header is written last, once the new offsets are known
+    const u32 headerSectors = sectorsFor(HEADER_BYTES, REGION_SECTOR_SIZE);
+    static const char zeros[V1_SECTOR_SIZE] = {};
+    for (u32 i = 0; i < headerSectors; ++i) {
+        out.write(zeros, REGION_SECTOR_SIZE);
+    }
+
+    std::vector<Entry> newTable(REGION_VOLUME);
+    u32 sector = headerSectors;
+    std::vector<u8> existing;
+    bool ok = true;
+    for (int i = 0; i < REGION_VOLUME && ok; ++i) {
+        const std::vector<u8>* payload = replaced[i];
+        if (!payload) {
+            if (table[i].sector == 0) continue;
+            // Never drop a stored chunk silently: a failed read aborts the rewrite
+            ok = read(i, existing);
+            payload = &existing;
+        }
+        if (!ok || payload->empty()) continue;
+
+        u32 length = static_cast<u32>(payload->size());
+        u32 sectors = sectorsFor(length, REGION_SECTOR_SIZE);
+        out.write(reinterpret_cast<const char*>(payload->data()), length);
+        out.write(zeros, sectors * REGION_SECTOR_SIZE - length);
+        newTable[i] = Entry{sector, length};
+        sector += sectors;
+    }
+
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(&MAGIC), sizeof(u32));
+    out.write(reinterpret_cast<const char*>(&VERSION), sizeof(u32));
+    out.write(reinterpret_cast<const char*>(newTable.data()), REGION_VOLUME * sizeof(Entry));
+    out.close();
+
+    std::error_code ec;
+    if (!ok || !out) {
+        LOG_ERROR("Failed to write region file " + tempPath);
+        fs::remove(tempPath, ec);
+        return false;
+    }
+
+    file.close();
+    // Offsets of a leftover journal would point into the old layout
+    fs::remove(journalPath, ec);
+    fs::rename(tempPath, path, ec);
+    if (ec) {
+        LOG_ERROR("Failed to replace region file " + path + ": " + ec.message());
+        fs::remove(tempPath, ec);
+        open();
+        return false;
+    }
+    return open();
+}
+
+RegionStorage::RegionStorage(const std::string& directory, bool fresh)
+    : directory(directory), fresh(fresh) {
+}
+
+RegionStorage::Region* RegionStorage::getRegion(const glm::ivec3& region) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = regions.find(region);
+    if (it != regions.end()) return it->second.get();
+
+    std::string path = directory + "/r." + std::to_string(region.x) + "." +
+                       std::to_string(region.y) + "." + std::to_string(region.z) + ".mcr";
+    auto entry = std::make_unique<Region>(path);
+    entry->file.open(); // A missing file just reads as empty until the first write
+    Region* result = entry.get();
+    regions[region] = std::move(entry);
+    return result;
+}
+
+bool RegionStorage::readChunk(const ChunkPos& pos, std::vector<u8>& out) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (fresh) return false;
+    }
+
+    Region* region = getRegion(RegionFile::regionOf(pos));
+    std::lock_guard<std::mutex> lock(region->mutex);
+    return region->file.read(RegionFile::localIndex(pos), out);
+}
+
+bool RegionStorage::hasChunk(const ChunkPos& pos) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (fresh) return false;
+    }
+
+    Region* region = getRegion(RegionFile::regionOf(pos));
+    std::lock_guard<std::mutex> lock(region->mutex);
+    return region->file.contains(RegionFile::localIndex(pos));
+}
+
+bool RegionStorage::writeChunks(const std::vector<std::pair<ChunkPos, std::vector<u8>>>& chunks) {
+    if (chunks.empty()) return true;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (fresh) {
+            // First write of a new world: forget the previous world's regions.
+            // Nothing was read while fresh, so no region is open yet.
+            std::error_code ec;
+            fs::remove_all(directory, ec);
+            fresh = false;
+        }
+    }
+    fs::create_directories(directory);
+
+    std::unordered_map<glm::ivec3, std::vector<std::pair<int, const std::vector<u8>*>>> byRegion;
+    for (const auto& [pos, payload] : chunks) {
+        byRegion[RegionFile::regionOf(pos)].emplace_back(RegionFile::localIndex(pos), &payload);
+    }
+
+    bool ok = true;
+    for (const auto& [regionPos, updates] : byRegion) {
+        Region* region = getRegion(regionPos);
+        std::lock_guard<std::mutex> lock(region->mutex);
+        ok = region->file.write(updates) && ok;
+    }
+    return ok;
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "../Util/Types.h"
+#include "../Util/Config.h"
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// One REGION_SIZE^3 block of chunks stored in a single file:
+//   u32 magic, u32 version
+//   REGION_VOLUME x { u32 sector, u32 length }   (sector 0 = chunk not stored)
+//   chunk payloads, each starting on a sector boundary
+// Version 2 files use REGION_SECTOR_SIZE sectors (sized for compressed payloads),
+// version 1 files 4 KB sectors (raw payloads); both are readable and writable,
+// compaction produces version 2. Payload bytes are opaque (see ChunkCodec).
+//
+// A write puts only the updated payloads into free or appended sectors, never over
+// sectors the offset table still points to. The new offsets then go to a small
+// journal (path.journal) before they are patched into the header, and open() replays
+// a complete journal, so a crash leaves either the old or the new offsets of a whole
+// batch. Once free sectors pass REGION_COMPACT_FREE_RATIO the region is compacted:
+// rewritten into a temporary file that replaces the original with a rename.
+class RegionFile {
+public:
+    explicit RegionFile(const std::string& path);
+    ~RegionFile() = default;
+
+    // Loads the offset table; false if the file doesn't exist (yet) or is invalid
+    bool open();
+    bool isOpen() const { return file.is_open(); }
+
+    bool read(int index, std::vector<u8>& out);
+    bool contains(int index) const { return table[index].sector != 0; }
+
+    // Stores the updates (index -> payload, empty = remove) as one atomic batch
+    bool write(const std::vector<std::pair<int, const std::vector<u8>*>>& updates);
+
+    // Slot of a chunk inside its region
+    static int localIndex(const ChunkPos& pos);
+    static glm::ivec3 regionOf(const ChunkPos& pos);
+
+private:
+    struct Entry {
+        u32 sector = 0;
+        u32 length = 0;
+    };
+
+    struct JournalRecord {
+        u32 index;
+        Entry entry;
+    };
+
+    static constexpr u32 MAGIC = 0x4D435247; // MCRG
+    static constexpr u32 JOURNAL_MAGIC = 0x4D43524A; // MCRJ
+    static constexpr u32 VERSION = 2;
+    static constexpr u32 V1_SECTOR_SIZE = 4096;
+    static constexpr u32 HEADER_BYTES = 8 + REGION_VOLUME * sizeof(Entry);
+
+    static u32 sectorsFor(u32 length, u32 sectorSize) { return (length + sectorSize - 1) / sectorSize; }
+    static u32 checksum(const std::vector<JournalRecord>& records);
+
+    // Writes every stored chunk plus the updates to a new file that replaces this one
+    bool compact(const std::vector<std::pair<int, const std::vector<u8>*>>& updates);
+    bool writeJournal(const std::vector<JournalRecord>& records);
+    bool replayJournal();
+    bool writeEntries(const std::vector<JournalRecord>& records);
+    u32 allocate(u32 sectors); // First free run that fits, else the end of the file
+    void markSectors(const Entry& entry, bool used);
+
+    std::string path;
+    std::string journalPath;
+    std::fstream file;
+    std::vector<Entry> table;
+    u32 sectorSize = REGION_SECTOR_SIZE;
+    u32 headerSectors = 0;
+    std::vector<bool> usedSectors;    // One flag per sector of the file, header included
+    u32 freeSectors = 0;
+};
+
+// Thread-safe set of region files for one world directory. Files are opened on
+// first access and kept open; regions that don't exist on disk are remembered
+// so chunk lookups for unsaved areas never touch the file system again.
+// Reads of a region wait while that region is being written, other regions
+// stay readable.
+class RegionStorage {
+public:
+    // A fresh storage replaces whatever the directory held, on its first write
+    // (a new world saved under an existing name)
+    explicit RegionStorage(const std::string& directory, bool fresh = false);
+    ~RegionStorage() = default;
+
+    bool readChunk(const ChunkPos& pos, std::vector<u8>& out);
+    bool hasChunk(const ChunkPos& pos);
+
+    // Writes a batch of chunks, one atomic region update per touched region
+    bool writeChunks(const std::vector<std::pair<ChunkPos, std::vector<u8>>>& chunks);
+
+    const std::string& getDirectory() const { return directory; }
+
+private:
+    struct Region {
+        std::mutex mutex;
+        RegionFile file;
+
+        explicit Region(const std::string& path) : file(path) {}
+    };
+
+    Region* getRegion(const glm::ivec3& region);
+
+    std::string directory;
+    bool fresh;
+    std::mutex mutex; // Guards regions / fresh
+    std::unordered_map<glm::ivec3, std::unique_ptr<Region>> regions;
+};
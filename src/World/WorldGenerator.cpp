@@ -1,16 +1,32 @@
 #include "WorldGenerator.h"
+#include "ColumnCache.h"
+#include "NoiseKernels.h"
 #include "../Util/Config.h"
+#include "../Core/Logger.h"
 #include "ChunkManager.h"
 #include <cmath>
 #include <random>
 #include <algorithm>
+#include <array>
+#include <limits>
+#include <mutex>
+#include <string>
 
-WorldGenerator::WorldGenerator(unsigned int seed) : seed(seed) {
+WorldGenerator::WorldGenerator(unsigned int seed)
+    : seed(seed), columnCache(std::make_unique<ColumnCache>()) {
     setSeed(seed);
+
+    static std::once_flag logged;
+    std::call_once(logged, [] {
+        LOG_INFO(std::string("Noise backend: ") + NoiseKernels::getBackendName(NoiseKernels::getBackend()));
+    });
 }
 
+WorldGenerator::~WorldGenerator() = default;
+
 void WorldGenerator::setSeed(unsigned int s) {
     seed = s;
+    columnCache->clear();
     std::mt19937 gen(seed);
     std::uniform_real_distribution<float> disOffset(-100000.0f, 100000.0f);
     std::uniform_real_distribution<float> disBias(-0.15f, 0.15f);
@@ -135,43 +151,47 @@ float WorldGenerator::getHumidity(float x, float z) const {
     return std::clamp(h + globalHumidBias, 0.0f, 1.0f);
 }
 
+void WorldGenerator::getTemperatureBatch(const float* x, const float* z, float* out, int count) const {
+    float tx[NOISE_BATCH_SIZE] = {}, tz[NOISE_BATCH_SIZE] = {};
+    for (int i = 0; i < count; ++i) {
+        tx[i] = x[i] * 0.0003f + offsetTempX;
+        tz[i] = z[i] * 0.0003f + offsetTempZ;
+    }
+    fbmBatch(tx, tz, 4, out, count);
+    for (int i = 0; i < count; ++i) {
+        float t = (out[i] + 1.0f) * 0.5f;
+        out[i] = std::clamp(t + globalTempBias, 0.0f, 1.0f);
+    }
+}
+
+void WorldGenerator::getHumidityBatch(const float* x, const float* z, float* out, int count) const {
+    float hx[NOISE_BATCH_SIZE] = {}, hz[NOISE_BATCH_SIZE] = {};
+    for (int i = 0; i < count; ++i) {
+        hx[i] = x[i] * 0.0003f + offsetHumidX;
+        hz[i] = z[i] * 0.0003f + offsetHumidZ;
+    }
+    fbmBatch(hx, hz, 4, out, count);
+    for (int i = 0; i < count; ++i) {
+        float h = (out[i] + 1.0f) * 0.5f;
+        out[i] = std::clamp(h + globalHumidBias, 0.0f, 1.0f);
+    }
+}
+
 BiomeType WorldGenerator::getBiome(float x, float z) const {
+    // Height and biome share the same noise layers, so sample them once
+    TerrainNoise n = sampleTerrainNoise(x, z);
+    return classifyBiome(n, getTemperature(x, z), getHumidity(x, z), combineHeight(n));
+}
+
+BiomeType WorldGenerator::classifyBiome(const TerrainNoise& n, float temp, float humid, float height) const {
     // Biome Selection matching the new terrain generation
+    float continentalness = n.continentalness;
     
-    // SCALE FACTORS - Must match getHeight
-    const float CONTINENT_SCALE = 0.0008f * globalFrequencyBias;
-    const float MOUNTAIN_SCALE = 0.002f * globalFrequencyBias;
-    
-    // 1. Continentalness (ocean vs land)
-    float contX = x * CONTINENT_SCALE + offsetContinentX;
-    float contZ = z * CONTINENT_SCALE + offsetContinentZ;
-    float warpX = contX, warpZ = contZ;
-    domainWarp(warpX, warpZ);
-    float continentalness = fbm(warpX, warpZ, 4);
-    // Must match getHeight() bias so biome/ocean decisions line up with terrain.
-    continentalness = std::clamp(continentalness + 0.12f, -1.0f, 1.0f);
-    
-    // 2. Mountain factor (same as getHeight)
-    float mtX = x * MOUNTAIN_SCALE + offsetErosionX;
-    float mtZ = z * MOUNTAIN_SCALE + offsetErosionZ;
-    float mtWarpX = mtX + 0.5f * noise2D(mtX * 0.5f + 1000.0f, mtZ * 0.5f + 2000.0f);
-    float mtWarpZ = mtZ + 0.5f * noise2D(mtX * 0.5f + 3000.0f, mtZ * 0.5f + 4000.0f);
-    float mountainNoise = ridgedMultifractal(mtWarpX, mtWarpZ, 5, 2.2f, 0.6f, 1.0f);
-    // Match getHeight
-    float mountainFactor = std::clamp((mountainNoise - 0.40f) * 3.1f, 0.0f, 1.0f);
-    
-    // 3. Temperature and humidity
-    float temp = getTemperature(x, z);
-    float humid = getHumidity(x, z);
-    
-    // Get actual height for height-based biome decisions
-    float height = getHeight(x, z);
+    // Mountain factor (same as getHeight)
+    float mountainFactor = std::clamp((n.mountainNoise - 0.40f) * 3.1f, 0.0f, 1.0f);
 
     // River mask (must match getHeight)
-    float rX = x * 0.0035f + offsetPVX * 0.25f + 31000.0f;
-    float rZ = z * 0.0035f + offsetPVZ * 0.25f + 42000.0f;
-    float riverBase = fbm(rX, rZ, 3);
-    float riverVal = 1.0f - std::abs(riverBase);
+    float riverVal = 1.0f - std::abs(n.riverBase);
     float riverMask = std::pow(std::clamp((riverVal - 0.78f) / 0.22f, 0.0f, 1.0f), 2.6f);
     
     // ========== BIOME SELECTION ==========
@@ -223,13 +243,48 @@ bool WorldGenerator::isCave(float x, float y, float z) const {
     // 1. Cheese Caves (Large Rooms)
     // Use lower frequency noise for large open areas
     float cheese = noise3D(x * 0.012f, y * 0.012f, z * 0.012f);
-    float cheeseThreshold = -0.55f + globalCaveDensityBias;
     
     // 2. Spaghetti Caves (Tunnels)
     // Use ridged noise (abs value close to 0)
     float worm1 = noise3D(x * 0.018f + 123.4f, y * 0.025f + 521.2f, z * 0.018f + 921.1f);
     float worm2 = noise3D(x * 0.018f + 921.4f, y * 0.025f + 123.2f, z * 0.018f + 521.1f);
     
+    return isCaveFromNoise(y, cheese, worm1, worm2);
+}
+
+void WorldGenerator::isCaveBatch(const float* x, const float* y, const float* z, bool* out, int count) const {
+    float cx[NOISE_BATCH_SIZE] = {}, cy[NOISE_BATCH_SIZE] = {}, cz[NOISE_BATCH_SIZE] = {};
+    float cheese[NOISE_BATCH_SIZE], worm1[NOISE_BATCH_SIZE], worm2[NOISE_BATCH_SIZE];
+
+    for (int i = 0; i < count; ++i) {
+        cx[i] = x[i] * 0.012f;
+        cy[i] = y[i] * 0.012f;
+        cz[i] = z[i] * 0.012f;
+    }
+    NoiseKernels::noise3D(seed, cx, cy, cz, cheese, count);
+
+    for (int i = 0; i < count; ++i) {
+        cx[i] = x[i] * 0.018f + 123.4f;
+        cy[i] = y[i] * 0.025f + 521.2f;
+        cz[i] = z[i] * 0.018f + 921.1f;
+    }
+    NoiseKernels::noise3D(seed, cx, cy, cz, worm1, count);
+
+    for (int i = 0; i < count; ++i) {
+        cx[i] = x[i] * 0.018f + 921.4f;
+        cy[i] = y[i] * 0.025f + 123.2f;
+        cz[i] = z[i] * 0.018f + 521.1f;
+    }
+    NoiseKernels::noise3D(seed, cx, cy, cz, worm2, count);
+
+    for (int i = 0; i < count; ++i) {
+        out[i] = !(y[i] > SEA_LEVEL + 10 || y[i] < 5) && isCaveFromNoise(y[i], cheese[i], worm1[i], worm2[i]);
+    }
+}
+
+bool WorldGenerator::isCaveFromNoise(float y, float cheese, float worm1, float worm2) const {
+    float cheeseThreshold = -0.55f + globalCaveDensityBias;
+    
     // Vary tunnel width based on depth
     float depthFactor = std::clamp((SEA_LEVEL - y) / 60.0f, 0.0f, 1.0f);
     float tunnelWidth = 0.05f + depthFactor * 0.04f; 
@@ -245,17 +300,21 @@ int WorldGenerator::getSurfaceHeight(int x, int z) const {
     return static_cast<int>(baseHeight);
 }
 
-bool WorldGenerator::hasTree(int x, int z, BiomeType biome) const {
-    // 1. Check if this position is a candidate based on probability
+float WorldGenerator::treeRoll(int x, int z) const {
     unsigned int seedX = static_cast<unsigned int>(x);
     unsigned int seedZ = static_cast<unsigned int>(z);
-    
+
     unsigned int h = seed + seedX * 374761393 + seedZ * 668265263;
     h = (h ^ (h >> 13)) * 1274126177;
-    float r = (h & 0xFFFF) / 65536.0f;
+    return (h & 0xFFFF) / 65536.0f;
+}
+
+bool WorldGenerator::hasTree(int x, int z, BiomeType biome) const {
+    // 1. Check if this position is a candidate based on probability
+    float r = treeRoll(x, z);
     
     float treeProb = 0.0f;
-    if (biome == BiomeType::FOREST) treeProb = 0.025f; 
+    if (biome == BiomeType::FOREST) treeProb = MAX_TREE_PROB;
     else if (biome == BiomeType::PLAINS) treeProb = 0.001f;
     else if (biome == BiomeType::MOUNTAINS) treeProb = 0.004f;
     // No trees in DESERT, OCEAN, SNOWY_TUNDRA (unless we add spruce later)
@@ -271,12 +330,7 @@ bool WorldGenerator::hasTree(int x, int z, BiomeType biome) const {
             
             int nx = x + dx;
             int nz = z + dz;
-            
-            unsigned int nSeedX = static_cast<unsigned int>(nx);
-            unsigned int nSeedZ = static_cast<unsigned int>(nz);
-            unsigned int nh = seed + nSeedX * 374761393 + nSeedZ * 668265263;
-            nh = (nh ^ (nh >> 13)) * 1274126177;
-            float nr = (nh & 0xFFFF) / 65536.0f;
+            float nr = treeRoll(nx, nz);
             
             // If neighbor is also a candidate
             if (nr < treeProb) {
@@ -298,9 +352,155 @@ int WorldGenerator::getTreeHeight(int x, int z) const {
     return 4 + (h % 5); 
 }
 
+std::shared_ptr<const ColumnData> WorldGenerator::getColumnData(int chunkX, int chunkZ) {
+    auto cached = columnCache->find(chunkX, chunkZ);
+    if (cached && cached->seed == seed) {
+        return cached;
+    }
+    return columnCache->insert(chunkX, chunkZ, computeColumnData(chunkX, chunkZ));
+}
+
+WorldGenerator::ColumnExtent WorldGenerator::getColumnExtent(int chunkX, int chunkZ) {
+    auto column = getColumnData(chunkX, chunkZ);
+
+    // Highest block generate() places: surface plants, sea / ice, tree canopies
+    int top = std::max(column->maxHeight, SEA_LEVEL - 1);
+    for (const TreeCandidate& tree : column->trees) {
+        top = std::max(top, tree.baseY + tree.height + 1);
+    }
+    // Everything below the surface layers is stone, caves aside
+    int stoneTop = std::numeric_limits<int>::max();
+    for (int idx = 0; idx < CHUNK_AREA; ++idx) {
+        stoneTop = std::min(stoneTop, column->surfaceHeight[idx] - getBiomeInfo(column->biome[idx]).surfaceDepth);
+    }
+    int solidTop = std::min(stoneTop, CAVE_MIN_Y) - 1;
+
+    ColumnExtent extent{MIN_CHUNK_Y, MAX_CHUNK_Y};
+    while (extent.minChunkY < extent.maxChunkY && (extent.minChunkY + 1) * CHUNK_HEIGHT - 1 <= solidTop) {
+        extent.minChunkY++;
+    }
+    while (extent.maxChunkY > extent.minChunkY && extent.maxChunkY * CHUNK_HEIGHT > top) {
+        extent.maxChunkY--;
+    }
+    return extent;
+}
+
+std::shared_ptr<ColumnData> WorldGenerator::computeColumnData(int chunkX, int chunkZ) const {
+    auto column = std::make_shared<ColumnData>();
+    column->seed = seed;
+
+    int baseX = chunkX * CHUNK_SIZE;
+    int baseZ = chunkZ * CHUNK_SIZE;
+
+    // 1. Heightmap, biome and temperature for the 16x16 column
+    column->minHeight = std::numeric_limits<int>::max();
+    column->maxHeight = std::numeric_limits<int>::min();
+    // All 256 columns go through the batch noise kernels in one pass
+    float columnX[CHUNK_AREA], columnZ[CHUNK_AREA];
+    for (int z = 0; z < CHUNK_SIZE; ++z) {
+        for (int x = 0; x < CHUNK_SIZE; ++x) {
+            int idx = ColumnData::index(x, z);
+            columnX[idx] = static_cast<float>(baseX + x);
+            columnZ[idx] = static_cast<float>(baseZ + z);
+        }
+    }
+
+    TerrainNoise terrain[CHUNK_AREA];
+    float humidity[CHUNK_AREA];
+    sampleTerrainNoiseBatch(columnX, columnZ, terrain, CHUNK_AREA);
+    getTemperatureBatch(columnX, columnZ, column->temperature.data(), CHUNK_AREA);
+    getHumidityBatch(columnX, columnZ, humidity, CHUNK_AREA);
+
+    for (int idx = 0; idx < CHUNK_AREA; ++idx) {
+        // Same height feeds both the biome and the surface (getBiome would recompute it)
+        float height = combineHeight(terrain[idx]);
+        column->surfaceHeight[idx] = static_cast<int>(height);
+        column->biome[idx] = classifyBiome(terrain[idx], column->temperature[idx], humidity[idx], height);
+
+        column->minHeight = std::min(column->minHeight, column->surfaceHeight[idx]);
+        column->maxHeight = std::max(column->maxHeight, column->surfaceHeight[idx]);
+    }
+
+    // 2. Trees whose canopy can reach into this column (Neighborhood Search)
+    int pad = 2;
+    for (int nx = -pad; nx < CHUNK_SIZE + pad; ++nx) {
+        for (int nz = -pad; nz < CHUNK_SIZE + pad; ++nz) {
+            int worldX = baseX + nx;
+            int worldZ = baseZ + nz;
+
+            // Cheap rejection before the (expensive) biome lookup: no biome exceeds MAX_TREE_PROB
+            if (treeRoll(worldX, worldZ) >= MAX_TREE_PROB) continue;
+
+            bool inside = nx >= 0 && nx < CHUNK_SIZE && nz >= 0 && nz < CHUNK_SIZE;
+            BiomeType biome;
+            int treeBaseY;
+            if (inside) {
+                biome = column->biome[ColumnData::index(nx, nz)];
+                treeBaseY = column->surfaceHeight[ColumnData::index(nx, nz)];
+            } else {
+                float fx = static_cast<float>(worldX);
+                float fz = static_cast<float>(worldZ);
+                TerrainNoise n = sampleTerrainNoise(fx, fz);
+                float height = combineHeight(n);
+                biome = classifyBiome(n, getTemperature(fx, fz), getHumidity(fx, fz), height);
+                treeBaseY = static_cast<int>(height);
+            }
+
+            if (!hasTree(worldX, worldZ, biome)) continue;
+            if (treeBaseY < SEA_LEVEL) continue;
+            if (isCave(static_cast<float>(worldX), static_cast<float>(treeBaseY - 1), static_cast<float>(worldZ))) continue;
+
+            column->trees.push_back({worldX, worldZ, treeBaseY, getTreeHeight(worldX, worldZ)});
+        }
+    }
+
+    return column;
+}
+
 void WorldGenerator::generate(std::shared_ptr<Chunk> chunk) {
     const ChunkPos& chunkPos = chunk->getPosition();
     glm::vec3 worldPos = ChunkManager::chunkToWorld(chunkPos);
+    auto column = getColumnData(chunkPos.x, chunkPos.z);
+
+    // Build into a dense scratch array and hand it to the chunk once, so the
+    // paletted storage is packed at its final width (no promotions per block).
+    // The terrain pass writes every block, so the chunk's old blocks aren't copied in.
+    std::array<Block, CHUNK_VOLUME> blocks;
+    auto getLocal = [&blocks](int x, int y, int z) {
+        if (x < 0 || x >= CHUNK_SIZE || y < 0 || y >= CHUNK_HEIGHT || z < 0 || z >= CHUNK_SIZE) return Block(BlockType::AIR);
+        return blocks[y * CHUNK_AREA + z * CHUNK_SIZE + x];
+    };
+    auto setLocal = [&blocks](int x, int y, int z, Block block) {
+        if (x < 0 || x >= CHUNK_SIZE || y < 0 || y >= CHUNK_HEIGHT || z < 0 || z >= CHUNK_SIZE) return;
+        blocks[y * CHUNK_AREA + z * CHUNK_SIZE + x] = block;
+    };
+
+    // Cave mask for the whole chunk, batched one x-slice (16x16) at a time.
+    // Chunks entirely outside the cave band skip the noise altogether.
+    static_assert(CHUNK_SIZE * CHUNK_HEIGHT <= NOISE_BATCH_SIZE, "cave slice exceeds noise batch size");
+    bool caveMask[CHUNK_VOLUME] = {};
+    int chunkMinY = static_cast<int>(worldPos.y);
+    int chunkMaxY = chunkMinY + CHUNK_HEIGHT - 1;
+    if (chunkMaxY >= CAVE_MIN_Y && chunkMinY <= SEA_LEVEL + 10) {
+        float cx[CHUNK_SIZE * CHUNK_HEIGHT], cy[CHUNK_SIZE * CHUNK_HEIGHT], cz[CHUNK_SIZE * CHUNK_HEIGHT];
+        bool slice[CHUNK_SIZE * CHUNK_HEIGHT];
+        for (int x = 0; x < CHUNK_SIZE; ++x) {
+            for (int z = 0; z < CHUNK_SIZE; ++z) {
+                for (int y = 0; y < CHUNK_HEIGHT; ++y) {
+                    int i = z * CHUNK_HEIGHT + y;
+                    cx[i] = static_cast<float>(static_cast<int>(worldPos.x) + x);
+                    cy[i] = static_cast<float>(chunkMinY + y);
+                    cz[i] = static_cast<float>(static_cast<int>(worldPos.z) + z);
+                }
+            }
+            isCaveBatch(cx, cy, cz, slice, CHUNK_SIZE * CHUNK_HEIGHT);
+            for (int z = 0; z < CHUNK_SIZE; ++z) {
+                for (int y = 0; y < CHUNK_HEIGHT; ++y) {
+                    caveMask[y * CHUNK_AREA + z * CHUNK_SIZE + x] = slice[z * CHUNK_HEIGHT + y];
+                }
+            }
+        }
+    }
     
     // 1. Terrain Pass
     for (int x = 0; x < CHUNK_SIZE; ++x) {
@@ -308,20 +508,21 @@ void WorldGenerator::generate(std::shared_ptr<Chunk> chunk) {
             int worldX = static_cast<int>(worldPos.x) + x;
             int worldZ = static_cast<int>(worldPos.z) + z;
             
-            BiomeType biome = getBiome(static_cast<float>(worldX), static_cast<float>(worldZ));
+            int columnIdx = ColumnData::index(x, z);
+            BiomeType biome = column->biome[columnIdx];
             BiomeInfo biomeInfo = getBiomeInfo(biome);
-            float temp = getTemperature(static_cast<float>(worldX), static_cast<float>(worldZ));
+            float temp = column->temperature[columnIdx];
             
-            int height = getSurfaceHeight(worldX, worldZ);
+            int height = column->surfaceHeight[columnIdx];
             
             for (int y = 0; y < CHUNK_HEIGHT; ++y) {
                 int worldY = static_cast<int>(worldPos.y) + y;
                 BlockType blockType = BlockType::AIR;
                 
-                bool isInCave = isCave(static_cast<float>(worldX), static_cast<float>(worldY), static_cast<float>(worldZ));
+                bool isInCave = caveMask[y * CHUNK_AREA + z * CHUNK_SIZE + x];
                 
                 // Bedrock Layer at Y = -64
-                if (worldY <= -64) {
+                if (worldY <= BEDROCK_Y) {
                     blockType = BlockType::BEDROCK;
                     isInCave = false; // No caves in bedrock
                 } else if (!isInCave) {
@@ -354,7 +555,7 @@ void WorldGenerator::generate(std::shared_ptr<Chunk> chunk) {
                     }
                 }
                 
-                chunk->setBlock(x, y, z, Block(blockType));
+                setLocal(x, y, z, Block(blockType));
             }
             
             // 2. Vegetation Pass (Plants)
@@ -363,7 +564,7 @@ void WorldGenerator::generate(std::shared_ptr<Chunk> chunk) {
                 if (height < SEA_LEVEL) continue;
 
                 int localY = height - chunkBaseY;
-                Block below = chunk->getBlock(x, localY - 1, z);
+                Block below = getLocal(x, localY - 1, z);
                 if (below.getType() == BlockType::GRASS) {
                     unsigned int h = seed + worldX * 374761393 + worldZ * 668265263;
                     h = (h ^ (h >> 13)) * 1274126177;
@@ -377,85 +578,77 @@ void WorldGenerator::generate(std::shared_ptr<Chunk> chunk) {
                     if (r < plantProb) {
                         BlockType plant = BlockType::TALL_GRASS;
                         if (((h >> 16) & 0xFF) < 25) plant = BlockType::ROSE; // ~10% chance
-                        chunk->setBlock(x, localY, z, Block(plant));
+                        setLocal(x, localY, z, Block(plant));
                     }
                 }
             }
         }
     }
     
-    // 3. Tree Pass (Neighborhood Search)
-    int pad = 2;
-    for (int nx = -pad; nx < CHUNK_SIZE + pad; ++nx) {
-        for (int nz = -pad; nz < CHUNK_SIZE + pad; ++nz) {
-            int worldX = static_cast<int>(worldPos.x) + nx;
-            int worldZ = static_cast<int>(worldPos.z) + nz;
-            
-            BiomeType biome = getBiome(static_cast<float>(worldX), static_cast<float>(worldZ));
-            
-            if (hasTree(worldX, worldZ, biome)) {
-                int treeBaseY = getSurfaceHeight(worldX, worldZ);
-                
-                if (treeBaseY < SEA_LEVEL) continue;
-                if (isCave(static_cast<float>(worldX), static_cast<float>(treeBaseY - 1), static_cast<float>(worldZ))) continue;
-
-                int treeH = getTreeHeight(worldX, worldZ);
-                
-                int chunkBaseY = static_cast<int>(worldPos.y);
-                int treeTopY = treeBaseY + treeH + 1;
-                
-                if (treeTopY < chunkBaseY || treeBaseY > chunkBaseY + CHUNK_HEIGHT) continue;
-                
-                // Draw Trunk
-                if (nx >= 0 && nx < CHUNK_SIZE && nz >= 0 && nz < CHUNK_SIZE) {
-                    for (int i = 0; i < treeH; ++i) {
-                        int wy = treeBaseY + i;
-                        if (wy >= chunkBaseY && wy < chunkBaseY + CHUNK_HEIGHT) {
-                            chunk->setBlock(nx, wy - chunkBaseY, nz, Block(BlockType::LOG));
-                        }
-                    }
+    // 3. Tree Pass (candidates precomputed per column)
+    for (const TreeCandidate& tree : column->trees) {
+        int worldX = tree.worldX;
+        int worldZ = tree.worldZ;
+        int nx = worldX - static_cast<int>(worldPos.x);
+        int nz = worldZ - static_cast<int>(worldPos.z);
+        int treeBaseY = tree.baseY;
+        int treeH = tree.height;
+        
+        int chunkBaseY = static_cast<int>(worldPos.y);
+        int treeTopY = treeBaseY + treeH + 1;
+        
+        if (treeTopY < chunkBaseY || treeBaseY > chunkBaseY + CHUNK_HEIGHT) continue;
+        
+        // Draw Trunk
+        if (nx >= 0 && nx < CHUNK_SIZE && nz >= 0 && nz < CHUNK_SIZE) {
+            for (int i = 0; i < treeH; ++i) {
+                int wy = treeBaseY + i;
+                if (wy >= chunkBaseY && wy < chunkBaseY + CHUNK_HEIGHT) {
+                    setLocal(nx, wy - chunkBaseY, nz, Block(BlockType::LOG));
                 }
-                
-                // Draw Leaves
-                unsigned int h = seed + worldX * 34123 + worldZ * 23123;
-                h = (h ^ (h >> 13)) * 1274126177;
-                bool extraLeaves = (h % 2) == 0;
+            }
+        }
+        
+        // Draw Leaves
+        unsigned int h = seed + worldX * 34123 + worldZ * 23123;
+        h = (h ^ (h >> 13)) * 1274126177;
+        bool extraLeaves = (h % 2) == 0;
 
-                for (int ly = treeBaseY + treeH - 3; ly <= treeBaseY + treeH; ++ly) {
-                    if (ly < chunkBaseY || ly >= chunkBaseY + CHUNK_HEIGHT) continue;
-                    
-                    int dy = ly - (treeBaseY + treeH);
-                    int radius = (dy >= -1) ? 1 : 2;
+        for (int ly = treeBaseY + treeH - 3; ly <= treeBaseY + treeH; ++ly) {
+            if (ly < chunkBaseY || ly >= chunkBaseY + CHUNK_HEIGHT) continue;
+            
+            int dy = ly - (treeBaseY + treeH);
+            int radius = (dy >= -1) ? 1 : 2;
+            
+            for (int lx = worldX - radius; lx <= worldX + radius; ++lx) {
+                for (int lz = worldZ - radius; lz <= worldZ + radius; ++lz) {
+                    int localX = lx - static_cast<int>(worldPos.x);
+                    int localZ = lz - static_cast<int>(worldPos.z);
                     
-                    for (int lx = worldX - radius; lx <= worldX + radius; ++lx) {
-                        for (int lz = worldZ - radius; lz <= worldZ + radius; ++lz) {
-                            int localX = lx - static_cast<int>(worldPos.x);
-                            int localZ = lz - static_cast<int>(worldPos.z);
-                            
-                            if (localX >= 0 && localX < CHUNK_SIZE && localZ >= 0 && localZ < CHUNK_SIZE) {
-                                bool isCorner = std::abs(lx - worldX) == radius && std::abs(lz - worldZ) == radius;
-                                
-                                if (isCorner) {
-                                    if (radius == 1) continue;
-                                    if (radius == 2) {
-                                        if (!extraLeaves || (h % 3 != 0)) continue; 
-                                    }
-                                }
-
-                                if (lx == worldX && lz == worldZ) continue;
-                                
-                                Block existing = chunk->getBlock(localX, ly - chunkBaseY, localZ);
-                                if (existing.getType() == BlockType::AIR || existing.isCrossModel()) {
-                                    chunk->setBlock(localX, ly - chunkBaseY, localZ, Block(BlockType::LEAVES));
-                                }
+                    if (localX >= 0 && localX < CHUNK_SIZE && localZ >= 0 && localZ < CHUNK_SIZE) {
+                        bool isCorner = std::abs(lx - worldX) == radius && std::abs(lz - worldZ) == radius;
+                        
+                        if (isCorner) {
+                            if (radius == 1) continue;
+                            if (radius == 2) {
+                                if (!extraLeaves || (h % 3 != 0)) continue; 
                             }
                         }
+
+                        if (lx == worldX && lz == worldZ) continue;
+                        
+                        Block existing = getLocal(localX, ly - chunkBaseY, localZ);
+                        if (existing.getType() == BlockType::AIR || existing.isCrossModel()) {
+                            setLocal(localX, ly - chunkBaseY, localZ, Block(BlockType::LEAVES));
+                        }
                     }
                 }
             }
         }
     }
     
+    chunk->setBlocks(blocks.data());
+    chunk->setModified(false); // Reproducible from the seed, so there's nothing to save
     chunk->setState(ChunkState::MESH_BUILD);
 }
 
@@ -465,7 +658,7 @@ float WorldGenerator::getNoise(float x, float y, float z) const {
     return noise3D(x * NOISE_SCALE, y * NOISE_SCALE, z * NOISE_SCALE);
 }
 
-float WorldGenerator::getHeight(float x, float z) const {
+WorldGenerator::TerrainNoise WorldGenerator::sampleTerrainNoise(float x, float z) const {
     // =====================================================
     // REALISTIC TERRAIN GENERATION
     // Creates: Ocean, Beaches, Plains, Hills, Mountain Ranges
@@ -477,6 +670,8 @@ float WorldGenerator::getHeight(float x, float z) const {
     const float HILLS_SCALE = 0.008f * globalFrequencyBias;        // Hills (~125 blocks)
     const float DETAIL_SCALE = 0.03f * globalFrequencyBias;        // Local detail (~33 blocks)
     
+    TerrainNoise n;
+
     // ========== 1. CONTINENTALNESS ==========
     // Determines ocean vs land. Warped for natural coastlines.
     float contX = x * CONTINENT_SCALE + offsetContinentX;
@@ -487,10 +682,9 @@ float WorldGenerator::getHeight(float x, float z) const {
     domainWarp(warpX, warpZ);
     
     // Multi-octave for continental shapes
-    float continentalness = fbm(warpX, warpZ, 4);
     // Bias towards land so the world isn't overly ocean-heavy.
     // This is the simplest way to get more flatlands without changing SEA_LEVEL.
-    continentalness = std::clamp(continentalness + 0.12f, -1.0f, 1.0f);
+    n.continentalness = std::clamp(fbm(warpX, warpZ, 4) + 0.12f, -1.0f, 1.0f);
     
     // ========== 2. MOUNTAIN RANGE NOISE ==========
     // Separate noise layer specifically for mountain ranges
@@ -503,37 +697,187 @@ float WorldGenerator::getHeight(float x, float z) const {
     float mtWarpZ = mtZ + 0.5f * noise2D(mtX * 0.5f + 3000.0f, mtZ * 0.5f + 4000.0f);
     
     // Use ridged multifractal for mountain chains
-    float mountainNoise = ridgedMultifractal(mtWarpX, mtWarpZ, 5, 2.2f, 0.6f, 1.0f);
-    
-    // Create clear mountain vs non-mountain distinction (visible ranges, but not everywhere)
-    float mountainFactor = std::clamp((mountainNoise - 0.40f) * 3.1f, 0.0f, 1.0f);
-    
-    // Choose between sharp and gentle mountain styles per-range so both can spawn
-    float mountainStyleNoise = (noise2D(mtWarpX * 0.6f + 7200.0f, mtWarpZ * 0.6f + 9100.0f) + 1.0f) * 0.5f;
-    float sharpWeight = std::pow(std::clamp(mountainStyleNoise, 0.0f, 1.0f), 1.4f);
-    float gentleWeight = std::pow(1.0f - mountainStyleNoise, 1.4f);
-    float weightSum = sharpWeight + gentleWeight + 1e-6f;
-    sharpWeight /= weightSum;
-    gentleWeight /= weightSum;
+    n.mountainNoise = ridgedMultifractal(mtWarpX, mtWarpZ, 5, 2.2f, 0.6f, 1.0f);
+    n.mountainStyle = noise2D(mtWarpX * 0.6f + 7200.0f, mtWarpZ * 0.6f + 9100.0f);
     
     // ========== 3. HILLS / EROSION NOISE ==========
     // Medium scale for rolling hills
     float hillX = x * HILLS_SCALE + offsetPVX;
     float hillZ = z * HILLS_SCALE + offsetPVZ;
     
-    float hillNoise = fbm(hillX, hillZ, 4);
+    n.hillNoise = fbm(hillX, hillZ, 4);
     // Turbulence adds more interesting hill shapes
-    float hillTurb = turbulence(hillX * 1.5f, hillZ * 1.5f, 3);
-    float hills = lerp(hillNoise, hillTurb * 2.0f - 1.0f, 0.3f);
+    n.hillTurb = turbulence(hillX * 1.5f, hillZ * 1.5f, 3);
     
     // ========== 4. DETAIL NOISE ==========
     // High frequency detail for local terrain variation
     float detX = x * DETAIL_SCALE + 5000.0f;
     float detZ = z * DETAIL_SCALE + 6000.0f;
-    float detail = fbm(detX, detZ, 4);
+    n.detail = fbm(detX, detZ, 4);
+
+    // Ocean islands only matter where continentalness is low
+    n.island = 0.0f;
+    if (n.continentalness < -0.30f) {
+        float iX = x * 0.004f + offsetContinentX * 0.15f + 10000.0f;
+        float iZ = z * 0.004f + offsetContinentZ * 0.15f + 20000.0f;
+        n.island = fbm(iX, iZ, 4);
+    }
+
+    // Mountain shape layers
+    n.peakDetail = ridgedMultifractal(detX * 2.2f, detZ * 2.2f, 4, 2.0f, 0.5f, 1.0f);
+    n.gentleShape = billowNoise(mtWarpX * 1.1f, mtWarpZ * 1.1f);
+    n.gentleDetail = fbm(mtWarpX * 0.7f, mtWarpZ * 0.7f, 3);
+
+    // River channels
+    float rX = x * 0.0035f + offsetPVX * 0.25f + 31000.0f;
+    float rZ = z * 0.0035f + offsetPVZ * 0.25f + 42000.0f;
+    n.riverBase = fbm(rX, rZ, 3);
+
+    return n;
+}
+
+void WorldGenerator::sampleTerrainNoiseBatch(const float* x, const float* z, TerrainNoise* out, int count) const {
+    // Same layers as sampleTerrainNoise, one noise layer at a time across all samples
+    const float CONTINENT_SCALE = 0.0008f * globalFrequencyBias;
+    const float MOUNTAIN_SCALE = 0.002f * globalFrequencyBias;
+    const float HILLS_SCALE = 0.008f * globalFrequencyBias;
+    const float DETAIL_SCALE = 0.03f * globalFrequencyBias;
+
+    float ax[NOISE_BATCH_SIZE] = {}, az[NOISE_BATCH_SIZE] = {};
+    float mtWarpX[NOISE_BATCH_SIZE] = {}, mtWarpZ[NOISE_BATCH_SIZE] = {};
+    float detX[NOISE_BATCH_SIZE] = {}, detZ[NOISE_BATCH_SIZE] = {};
+    float r[NOISE_BATCH_SIZE];
+
+    // 1. Continentalness
+    for (int i = 0; i < count; ++i) {
+        ax[i] = x[i] * CONTINENT_SCALE + offsetContinentX;
+        az[i] = z[i] * CONTINENT_SCALE + offsetContinentZ;
+    }
+    domainWarpBatch(ax, az, count);
+    fbmBatch(ax, az, 4, r, count);
+    for (int i = 0; i < count; ++i) out[i].continentalness = std::clamp(r[i] + 0.12f, -1.0f, 1.0f);
+
+    // 2. Mountain ranges
+    float mtX[NOISE_BATCH_SIZE], mtZ[NOISE_BATCH_SIZE];
+    for (int i = 0; i < count; ++i) {
+        mtX[i] = x[i] * MOUNTAIN_SCALE + offsetErosionX;
+        mtZ[i] = z[i] * MOUNTAIN_SCALE + offsetErosionZ;
+        ax[i] = mtX[i] * 0.5f + 1000.0f;
+        az[i] = mtZ[i] * 0.5f + 2000.0f;
+    }
+    noise2DBatch(ax, az, r, count);
+    for (int i = 0; i < count; ++i) {
+        mtWarpX[i] = mtX[i] + 0.5f * r[i];
+        ax[i] = mtX[i] * 0.5f + 3000.0f;
+        az[i] = mtZ[i] * 0.5f + 4000.0f;
+    }
+    noise2DBatch(ax, az, r, count);
+    for (int i = 0; i < count; ++i) mtWarpZ[i] = mtZ[i] + 0.5f * r[i];
+
+    ridgedMultifractalBatch(mtWarpX, mtWarpZ, 5, 2.2f, 0.6f, 1.0f, r, count);
+    for (int i = 0; i < count; ++i) out[i].mountainNoise = r[i];
+
+    for (int i = 0; i < count; ++i) {
+        ax[i] = mtWarpX[i] * 0.6f + 7200.0f;
+        az[i] = mtWarpZ[i] * 0.6f + 9100.0f;
+    }
+    noise2DBatch(ax, az, r, count);
+    for (int i = 0; i < count; ++i) out[i].mountainStyle = r[i];
+
+    // 3. Hills
+    for (int i = 0; i < count; ++i) {
+        ax[i] = x[i] * HILLS_SCALE + offsetPVX;
+        az[i] = z[i] * HILLS_SCALE + offsetPVZ;
+    }
+    fbmBatch(ax, az, 4, r, count);
+    for (int i = 0; i < count; ++i) {
+        out[i].hillNoise = r[i];
+        ax[i] = ax[i] * 1.5f;
+        az[i] = az[i] * 1.5f;
+    }
+    turbulenceBatch(ax, az, 3, r, count);
+    for (int i = 0; i < count; ++i) out[i].hillTurb = r[i];
+
+    // 4. Detail
+    for (int i = 0; i < count; ++i) {
+        detX[i] = x[i] * DETAIL_SCALE + 5000.0f;
+        detZ[i] = z[i] * DETAIL_SCALE + 6000.0f;
+    }
+    fbmBatch(detX, detZ, 4, r, count);
+    for (int i = 0; i < count; ++i) out[i].detail = r[i];
+
+    // Islands (evaluated everywhere here; combineHeight only reads them in oceans)
+    for (int i = 0; i < count; ++i) {
+        ax[i] = x[i] * 0.004f + offsetContinentX * 0.15f + 10000.0f;
+        az[i] = z[i] * 0.004f + offsetContinentZ * 0.15f + 20000.0f;
+    }
+    fbmBatch(ax, az, 4, r, count);
+    for (int i = 0; i < count; ++i) out[i].island = out[i].continentalness < -0.30f ? r[i] : 0.0f;
+
+    // Mountain shape layers
+    for (int i = 0; i < count; ++i) {
+        ax[i] = detX[i] * 2.2f;
+        az[i] = detZ[i] * 2.2f;
+    }
+    ridgedMultifractalBatch(ax, az, 4, 2.0f, 0.5f, 1.0f, r, count);
+    for (int i = 0; i < count; ++i) out[i].peakDetail = r[i];
+
+    for (int i = 0; i < count; ++i) {
+        ax[i] = mtWarpX[i] * 1.1f;
+        az[i] = mtWarpZ[i] * 1.1f;
+    }
+    billowNoiseBatch(ax, az, r, count);
+    for (int i = 0; i < count; ++i) out[i].gentleShape = r[i];
+
+    for (int i = 0; i < count; ++i) {
+        ax[i] = mtWarpX[i] * 0.7f;
+        az[i] = mtWarpZ[i] * 0.7f;
+    }
+    fbmBatch(ax, az, 3, r, count);
+    for (int i = 0; i < count; ++i) out[i].gentleDetail = r[i];
+
+    // River channels
+    for (int i = 0; i < count; ++i) {
+        ax[i] = x[i] * 0.0035f + offsetPVX * 0.25f + 31000.0f;
+        az[i] = z[i] * 0.0035f + offsetPVZ * 0.25f + 42000.0f;
+    }
+    fbmBatch(ax, az, 3, r, count);
+    for (int i = 0; i < count; ++i) out[i].riverBase = r[i];
+}
+
+float WorldGenerator::getHeight(float x, float z) const {
+    return combineHeight(sampleTerrainNoise(x, z));
+}
+
+void WorldGenerator::getHeightBatch(const float* x, const float* z, float* out, int count) const {
+    TerrainNoise terrain[NOISE_BATCH_SIZE];
+    for (int start = 0; start < count; start += NOISE_BATCH_SIZE) {
+        int n = std::min(NOISE_BATCH_SIZE, count - start);
+        sampleTerrainNoiseBatch(x + start, z + start, terrain, n);
+        for (int i = 0; i < n; ++i) {
+            out[start + i] = combineHeight(terrain[i]);
+        }
+    }
+}
+
+float WorldGenerator::combineHeight(const TerrainNoise& n) const {
+    float continentalness = n.continentalness;
+
+    // Create clear mountain vs non-mountain distinction (visible ranges, but not everywhere)
+    float mountainFactor = std::clamp((n.mountainNoise - 0.40f) * 3.1f, 0.0f, 1.0f);
     
-    // ========== 5. COMBINE INTO FINAL HEIGHT ==========
+    // Choose between sharp and gentle mountain styles per-range so both can spawn
+    float mountainStyleNoise = (n.mountainStyle + 1.0f) * 0.5f;
+    float sharpWeight = std::pow(std::clamp(mountainStyleNoise, 0.0f, 1.0f), 1.4f);
+    float gentleWeight = std::pow(1.0f - mountainStyleNoise, 1.4f);
+    float weightSum = sharpWeight + gentleWeight + 1e-6f;
+    sharpWeight /= weightSum;
+    gentleWeight /= weightSum;
+    
+    float hills = lerp(n.hillNoise, n.hillTurb * 2.0f - 1.0f, 0.3f);
+    float detail = n.detail;
     
+    // ========== 5. COMBINE INTO FINAL HEIGHT ==========
     // Base height from continentalness (tuned for SEA_LEVEL = 32: more land, less overall ocean)
     float baseHeight;
     if (continentalness < -0.55f) {
@@ -564,9 +908,7 @@ float WorldGenerator::getHeight(float x, float z) const {
 
     // Ocean islands: allow land to pop up inside ocean regions
     if (continentalness < -0.30f) {
-        float iX = x * 0.004f + offsetContinentX * 0.15f + 10000.0f;
-        float iZ = z * 0.004f + offsetContinentZ * 0.15f + 20000.0f;
-        float islandN = (fbm(iX, iZ, 4) + 1.0f) * 0.5f;
+        float islandN = (n.island + 1.0f) * 0.5f;
         float islandMask = std::pow(std::clamp((islandN - 0.72f) / 0.28f, 0.0f, 1.0f), 2.2f);
         baseHeight += islandMask * 30.0f;
     }
@@ -579,11 +921,11 @@ float WorldGenerator::getHeight(float x, float z) const {
     
     // Mountain contribution (two styles: sharp ridges vs gentle, walkable slopes)
     // Reduce high-frequency peak noise a bit to avoid extremely sharp spires / "holey" peaks
-    float peakDetail = ridgedMultifractal(detX * 2.2f, detZ * 2.2f, 4, 2.0f, 0.5f, 1.0f);
+    float peakDetail = n.peakDetail;
     float sharpHeight = mountainFactor * (62.0f + peakDetail * 85.0f + detail * 16.0f) * landFactor;
     
-    float gentleShape = (billowNoise(mtWarpX * 1.1f, mtWarpZ * 1.1f) + 1.0f) * 0.5f; // softer, rounded peaks
-    float gentleDetail = (fbm(mtWarpX * 0.7f, mtWarpZ * 0.7f, 3) + 1.0f) * 0.5f;
+    float gentleShape = (n.gentleShape + 1.0f) * 0.5f; // softer, rounded peaks
+    float gentleDetail = (n.gentleDetail + 1.0f) * 0.5f;
     float gentleHeight = mountainFactor * (42.0f + gentleShape * 60.0f + gentleDetail * 14.0f) * landFactor;
     
     float mountainHeight = sharpWeight * sharpHeight + gentleWeight * gentleHeight;
@@ -598,10 +940,7 @@ float WorldGenerator::getHeight(float x, float z) const {
     float finalHeight = baseHeight + finalHillHeight + mountainHeight + detailHeight;
 
     // River carving: create river-like water channels instead of random inland water.
-    float rX = x * 0.0035f + offsetPVX * 0.25f + 31000.0f;
-    float rZ = z * 0.0035f + offsetPVZ * 0.25f + 42000.0f;
-    float riverBase = fbm(rX, rZ, 3);
-    float riverVal = 1.0f - std::abs(riverBase);
+    float riverVal = 1.0f - std::abs(n.riverBase);
     float riverMask = std::pow(std::clamp((riverVal - 0.78f) / 0.22f, 0.0f, 1.0f), 2.6f);
     riverMask *= landFactor;
     // Don't let rivers carve huge gashes through mountain cores
@@ -629,67 +968,7 @@ float WorldGenerator::getHeight(float x, float z) const {
 
 float WorldGenerator::noise3D(float x, float y, float z) const {
     // Improved Perlin Noise (Gradient Noise)
-    int xi = static_cast<int>(std::floor(x)) & 255;
-    int yi = static_cast<int>(std::floor(y)) & 255;
-    int zi = static_cast<int>(std::floor(z)) & 255;
-    
-    float xf = x - std::floor(x);
-    float yf = y - std::floor(y);
-    float zf = z - std::floor(z);
-    
-    float u = fade(xf);
-    float v = fade(yf);
-    float w = fade(zf);
-    
-    // Hash function with better mixing
-    auto hash = [&](int i, int j, int k) {
-        unsigned int h = seed;
-        h ^= i * 374761393;
-        h ^= j * 668265263;
-        h ^= k * 1274126177;
-        h ^= h >> 13;
-        h *= 0x5bd1e995;
-        h ^= h >> 15;
-        return h & 0xFFFFFF;
-    };
-
-    int aaa = hash(xi, yi, zi);
-    int aba = hash(xi, yi + 1, zi);
-    int aab = hash(xi, yi, zi + 1);
-    int abb = hash(xi, yi + 1, zi + 1);
-    int baa = hash(xi + 1, yi, zi);
-    int bba = hash(xi + 1, yi + 1, zi);
-    int bab = hash(xi + 1, yi, zi + 1);
-    int bbb = hash(xi + 1, yi + 1, zi + 1);
-    
-    // Calculate dot products
-    float val_aaa = grad(aaa, xf, yf, zf);
-    float val_aba = grad(aba, xf, yf - 1, zf);
-    float val_aab = grad(aab, xf, yf, zf - 1);
-    float val_abb = grad(abb, xf, yf - 1, zf - 1);
-    float val_baa = grad(baa, xf - 1, yf, zf);
-    float val_bba = grad(bba, xf - 1, yf - 1, zf);
-    float val_bab = grad(bab, xf - 1, yf, zf - 1);
-    float val_bbb = grad(bbb, xf - 1, yf - 1, zf - 1);
-    
-    // Trilinear interpolation
-    float x1 = lerp(val_aaa, val_baa, u);
-    float x2 = lerp(val_aba, val_bba, u);
-    float x3 = lerp(val_aab, val_bab, u);
-    float x4 = lerp(val_abb, val_bbb, u);
-    
-    float y1 = lerp(x1, x2, v);
-    float y2 = lerp(x3, x4, v);
-    
-    return lerp(y1, y2, w);
-}
-
-float WorldGenerator::grad(int hash, float x, float y, float z) const {
-    // Convert low 4 bits of hash code into 12 gradient directions
-    int h = hash & 15;
-    float u = h < 8 ? x : y;
-    float v = h < 4 ? y : h == 12 || h == 14 ? x : z;
-    return ((h & 1) == 0 ? u : -u) + ((h & 2) == 0 ? v : -v);
+    return NoiseKernels::noise3D(seed, x, y, z);
 }
 
 float WorldGenerator::noise2D(float x, float z) const {
@@ -723,11 +1002,6 @@ float WorldGenerator::lerp(float a, float b, float t) const {
     return a + t * (b - a);
 }
 
-float WorldGenerator::fade(float t) const {
-    // Quintic interpolation for smoother gradients
-    return t * t * t * (t * (t * 6.0f - 15.0f) + 10.0f);
-}
-
 float WorldGenerator::ridgeNoise(float x, float z) const {
     // Ridged multifractal noise
     // 1.0 - abs(noise) creates sharp peaks
@@ -836,6 +1110,131 @@ float WorldGenerator::domainWarp(float& x, float& z) const {
     return noise2D(x, z);
 }
 
+void WorldGenerator::noise2DBatch(const float* x, const float* z, float* out, int count) const {
+    NoiseKernels::noise2D(seed, x, z, out, count);
+}
+
+void WorldGenerator::fbmBatch(const float* x, const float* z, int octaves, float* out, int count) const {
+    // Octave-major so each octave is one batch noise call; same operation order as fbm()
+    float sx[NOISE_BATCH_SIZE], sz[NOISE_BATCH_SIZE], n[NOISE_BATCH_SIZE];
+    float frequency = 1.0f;
+    float amplitude = 1.0f;
+    float maxValue = 0.0f;
+
+    for (int i = 0; i < count; ++i) out[i] = 0.0f;
+
+    for (int o = 0; o < octaves; o++) {
+        for (int i = 0; i < count; ++i) {
+            sx[i] = x[i] * frequency;
+            sz[i] = z[i] * frequency;
+        }
+        noise2DBatch(sx, sz, n, count);
+        for (int i = 0; i < count; ++i) out[i] += n[i] * amplitude;
+
+        maxValue += amplitude;
+        amplitude *= 0.5f;
+        frequency *= 2.0f;
+    }
+
+    for (int i = 0; i < count; ++i) out[i] = out[i] / maxValue;
+}
+
+void WorldGenerator::turbulenceBatch(const float* x, const float* z, int octaves, float* out, int count) const {
+    float sx[NOISE_BATCH_SIZE], sz[NOISE_BATCH_SIZE], n[NOISE_BATCH_SIZE];
+    float frequency = 1.0f;
+    float amplitude = 1.0f;
+    float maxValue = 0.0f;
+
+    for (int i = 0; i < count; ++i) out[i] = 0.0f;
+
+    for (int o = 0; o < octaves; o++) {
+        for (int i = 0; i < count; ++i) {
+            sx[i] = x[i] * frequency;
+            sz[i] = z[i] * frequency;
+        }
+        noise2DBatch(sx, sz, n, count);
+        for (int i = 0; i < count; ++i) out[i] += std::abs(n[i]) * amplitude;
+
+        maxValue += amplitude;
+        amplitude *= 0.5f;
+        frequency *= 2.0f;
+    }
+
+    for (int i = 0; i < count; ++i) out[i] = out[i] / maxValue;
+}
+
+void WorldGenerator::ridgedMultifractalBatch(const float* x, const float* z, int octaves, float lacunarity, float gain, float offset, float* out, int count) const {
+    float sx[NOISE_BATCH_SIZE], sz[NOISE_BATCH_SIZE], n[NOISE_BATCH_SIZE];
+    float weight[NOISE_BATCH_SIZE];
+    float frequency = 1.0f;
+    float amplitude = 0.5f;
+
+    for (int i = 0; i < count; ++i) {
+        out[i] = 0.0f;
+        weight[i] = 1.0f;
+    }
+
+    for (int o = 0; o < octaves; o++) {
+        for (int i = 0; i < count; ++i) {
+            sx[i] = x[i] * frequency;
+            sz[i] = z[i] * frequency;
+        }
+        noise2DBatch(sx, sz, n, count);
+        for (int i = 0; i < count; ++i) {
+            float ridge = offset - std::abs(n[i]);
+            ridge = ridge * ridge;
+            ridge *= weight[i];
+            weight[i] = std::clamp(ridge * gain, 0.0f, 1.0f);
+            out[i] += ridge * amplitude;
+        }
+
+        frequency *= lacunarity;
+        amplitude *= gain;
+    }
+
+    for (int i = 0; i < count; ++i) out[i] = std::clamp(out[i], 0.0f, 1.0f);
+}
+
+void WorldGenerator::billowNoiseBatch(const float* x, const float* z, float* out, int count) const {
+    noise2DBatch(x, z, out, count);
+    for (int i = 0; i < count; ++i) out[i] = std::abs(out[i]) * 2.0f - 1.0f;
+}
+
+void WorldGenerator::domainWarpBatch(float* x, float* z, int count) const {
+    // Same two-layer warp as domainWarp(); the trailing noise sample isn't needed here
+    float ax[NOISE_BATCH_SIZE] = {}, az[NOISE_BATCH_SIZE] = {};
+    float qx[NOISE_BATCH_SIZE], qz[NOISE_BATCH_SIZE];
+    float rx[NOISE_BATCH_SIZE], rz[NOISE_BATCH_SIZE];
+
+    for (int i = 0; i < count; ++i) {
+        ax[i] = x[i] * 0.8f + 5.2f;
+        az[i] = z[i] * 0.8f + 1.3f;
+    }
+    noise2DBatch(ax, az, qx, count);
+    for (int i = 0; i < count; ++i) {
+        ax[i] = x[i] * 0.8f + 1.3f;
+        az[i] = z[i] * 0.8f + 5.2f;
+    }
+    noise2DBatch(ax, az, qz, count);
+
+    for (int i = 0; i < count; ++i) {
+        ax[i] = x[i] + 4.0f * qx[i] + 1.7f;
+        az[i] = z[i] + 4.0f * qz[i] + 9.2f;
+    }
+    noise2DBatch(ax, az, rx, count);
+    for (int i = 0; i < count; ++i) {
+        ax[i] = x[i] + 4.0f * qx[i] + 8.3f;
+        az[i] = z[i] + 4.0f * qz[i] + 2.8f;
+    }
+    noise2DBatch(ax, az, rz, count);
+
+    float warpStrength = 3.0f;
+    for (int i = 0; i < count; ++i) {
+        x[i] += warpStrength * rx[i];
+        z[i] += warpStrength * rz[i];
+    }
+}
+
 float WorldGenerator::getSplineHeight(float continentalness, float erosion, float pv) const {
     // Minecraft-like Spline Logic with Interpolation
     
@@ -24,20 +24,41 @@ struct BiomeInfo {
     int surfaceDepth;
 };
 
+struct ColumnData;
+class ColumnCache;
+
 class WorldGenerator {
 public:
     WorldGenerator(unsigned int seed = 12345);
-    ~WorldGenerator() = default;
+    ~WorldGenerator();
 
     void setSeed(unsigned int s);
     void generate(std::shared_ptr<Chunk> chunk);
     
     float getNoise(float x, float y, float z) const;
     float getHeight(float x, float z) const;
+    // Batch version of getHeight (bit-identical), evaluated with SIMD noise kernels
+    void getHeightBatch(const float* x, const float* z, float* out, int count) const;
     int getSurfaceHeight(int x, int z) const;
     BiomeType getBiome(float x, float z) const;
     BiomeInfo getBiomeInfo(BiomeType biome) const;
 
+    // Heightmap/biome/tree data for a chunk column, shared by all vertical chunks
+    std::shared_ptr<const ColumnData> getColumnData(int chunkX, int chunkZ);
+
+    // Chunks of a column that generate() can put anything but stone or air into. Chunks
+    // below minChunkY are plain stone on the bedrock floor (under the cave band and every
+    // surface layer), chunks above maxChunkY are empty sky (over terrain, sea and trees).
+    struct ColumnExtent {
+        int minChunkY;
+        int maxChunkY;
+    };
+    ColumnExtent getColumnExtent(int chunkX, int chunkZ);
+
+    static constexpr int BEDROCK_Y = -64;  // Bedrock at and below this height
+    static constexpr int CAVE_MIN_Y = 5;   // Chunks reaching into [CAVE_MIN_Y, SEA_LEVEL + 10] get caves
+    const ColumnCache& getColumnCache() const { return *columnCache; }
+
 private:
     unsigned int seed;
     
@@ -59,6 +80,30 @@ private:
     float globalCaveDensityBias = 0.0f; // -0.05 to 0.05
     float globalCaveWaterBias = 0.0f; // -1.0 to 0.0 (Dryer caves to Normal)
     float globalFrequencyBias = 1.0f; // 0.5 to 1.5 (Larger vs Smaller features)
+
+    std::unique_ptr<ColumnCache> columnCache;
+    std::shared_ptr<ColumnData> computeColumnData(int chunkX, int chunkZ) const;
+
+    // Raw noise layers behind getHeight/getBiome, so both can share one evaluation
+    struct TerrainNoise {
+        float continentalness; // Warped fbm, land-biased and clamped
+        float mountainNoise;   // Ridged multifractal on warped mountain coords
+        float mountainStyle;   // Sharp vs gentle mountain selector
+        float hillNoise;
+        float hillTurb;
+        float detail;
+        float island;          // Only sampled where continentalness < -0.30
+        float peakDetail;
+        float gentleShape;
+        float gentleDetail;
+        float riverBase;
+    };
+
+    static constexpr int NOISE_BATCH_SIZE = CHUNK_AREA; // Max samples per *Batch call
+
+    TerrainNoise sampleTerrainNoise(float x, float z) const;
+    void sampleTerrainNoiseBatch(const float* x, const float* z, TerrainNoise* out, int count) const;
+    float combineHeight(const TerrainNoise& n) const;
     
     // Simple Perlin-like noise
     float noise3D(float x, float y, float z) const;
@@ -70,8 +115,14 @@ private:
     float turbulence(float x, float z, int octaves) const; // Turbulent noise
     float domainWarp(float& x, float& z) const;
     float lerp(float a, float b, float t) const;
-    float fade(float t) const;
-    float grad(int hash, float x, float y, float z) const;
+
+    // Batch versions of the above (count <= NOISE_BATCH_SIZE, bit-identical results)
+    void noise2DBatch(const float* x, const float* z, float* out, int count) const;
+    void fbmBatch(const float* x, const float* z, int octaves, float* out, int count) const;
+    void ridgedMultifractalBatch(const float* x, const float* z, int octaves, float lacunarity, float gain, float offset, float* out, int count) const;
+    void billowNoiseBatch(const float* x, const float* z, float* out, int count) const;
+    void turbulenceBatch(const float* x, const float* z, int octaves, float* out, int count) const;
+    void domainWarpBatch(float* x, float* z, int count) const;
     
     // Spline helper
     float getSplineHeight(float continentalness, float erosion, float pv) const;
@@ -79,11 +130,18 @@ private:
     // Biome-related
     float getTemperature(float x, float z) const;
     float getHumidity(float x, float z) const;
+    void getTemperatureBatch(const float* x, const float* z, float* out, int count) const;
+    void getHumidityBatch(const float* x, const float* z, float* out, int count) const;
+    BiomeType classifyBiome(const TerrainNoise& n, float temp, float humid, float height) const;
     
     // Cave generation
     bool isCave(float x, float y, float z) const;
+    bool isCaveFromNoise(float y, float cheese, float worm1, float worm2) const;
+    void isCaveBatch(const float* x, const float* y, const float* z, bool* out, int count) const;
     
     // Vegetation helpers
+    static constexpr float MAX_TREE_PROB = 0.025f; // Highest per-biome tree probability (FOREST)
+    float treeRoll(int x, int z) const;
     bool hasTree(int x, int z, BiomeType biome) const;
     int getTreeHeight(int x, int z) const;
 };
@@ -1,4 +1,5 @@
 #include "WorldSerializer.h"
+#include "ChunkCodec.h"
 #include "../Core/Logger.h"
 #include <filesystem>
 #include <fstream>
@@ -14,65 +15,86 @@ std::string WorldSerializer::getWorldDirectory(const std::string& worldName) {
     return getSaveDirectory() + "/" + worldName;
 }
 
-bool WorldSerializer::saveWorld(const std::string& worldName, const ChunkManager& chunkManager, const glm::vec3& playerPos, long seed) {
+std::string WorldSerializer::getRegionDirectory(const std::string& worldName) {
+    return getWorldDirectory(worldName) + "/region";
+}
+
+std::shared_ptr<RegionStorage> WorldSerializer::openRegionStorage(const std::string& worldName, bool fresh) {
+    return std::make_shared<RegionStorage>(getRegionDirectory(worldName), fresh);
+}
+
+bool WorldSerializer::saveLevel(const std::string& worldName, const glm::vec3& playerPos, long seed) {
     std::string worldDir = getWorldDirectory(worldName);
-    
-    if (!fs::exists(worldDir)) {
-        fs::create_directories(worldDir);
-    }
-    
-    // Save level.dat
-    std::ofstream levelFile(worldDir + "/level.dat", std::ios::binary);
+    std::error_code ec;
+    fs::create_directories(worldDir, ec);
+
+    // Written next to the old file and renamed over it, so a crash never leaves a partial level.dat
+    std::string levelPath = worldDir + "/level.dat";
+    std::string tempPath = levelPath + ".tmp";
+    std::ofstream levelFile(tempPath, std::ios::binary | std::ios::trunc);
     if (!levelFile.is_open()) {
         LOG_ERROR("Failed to open level.dat for writing");
         return false;
     }
-    
+
     levelFile.write(reinterpret_cast<const char*>(&playerPos), sizeof(glm::vec3));
     levelFile.write(reinterpret_cast<const char*>(&seed), sizeof(long));
-    
     levelFile.close();
-    
-    // Save chunks to a single file
-    std::string chunksFile = worldDir + "/chunks.dat";
-    std::ofstream file(chunksFile, std::ios::binary);
-    if (!file.is_open()) {
-        LOG_ERROR("Failed to open chunks.dat for writing");
+
+    if (!levelFile) {
+        LOG_ERROR("Failed to write level.dat");
+        fs::remove(tempPath, ec);
         return false;
     }
+    fs::rename(tempPath, levelPath, ec);
+    if (ec) {
+        LOG_ERROR("Failed to replace level.dat: " + ec.message());
+        fs::remove(tempPath, ec);
+        return false;
+    }
+    return true;
+}
 
-    const auto& chunks = chunkManager.getChunks();
-    int savedCount = 0;
-    
-    // Count modified chunks first
-    for (const auto& [pos, chunk] : chunks) {
-        if (chunk->isModified()) {
-            savedCount++;
-        }
+void WorldSerializer::migrateLegacyChunks(const std::string& worldDir, RegionStorage& storage) {
+    std::string chunksFile = worldDir + "/chunks.dat";
+    if (!fs::exists(chunksFile)) return;
+
+    std::ifstream file(chunksFile, std::ios::binary);
+    if (!file.is_open()) return;
+
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    int count = 0;
+
+    file.read(reinterpret_cast<char*>(&magic), sizeof(uint32_t));
+    file.read(reinterpret_cast<char*>(&version), sizeof(uint32_t));
+    file.read(reinterpret_cast<char*>(&count), sizeof(int));
+
+    if (magic != 0x4D434350 || version != 1) {
+        LOG_ERROR("Unknown chunks.dat format, not migrated");
+        return;
     }
-    
-    // Write header: Magic, Version, Count
-    uint32_t magic = 0x4D434350; // MCCP (Minecraft C++ Project)
-    uint32_t version = 1;
-    file.write(reinterpret_cast<const char*>(&magic), sizeof(uint32_t));
-    file.write(reinterpret_cast<const char*>(&version), sizeof(uint32_t));
-    file.write(reinterpret_cast<const char*>(&savedCount), sizeof(int));
-    
-    for (const auto& [pos, chunk] : chunks) {
-        if (chunk->isModified()) {
-            // Write ChunkPos
-            file.write(reinterpret_cast<const char*>(&pos), sizeof(ChunkPos));
-            
-            // Write Block Data (Fixed size 4096 * sizeof(Block))
-            const auto& blocks = chunk->getBlocks();
-            file.write(reinterpret_cast<const char*>(blocks.data()), blocks.size() * sizeof(Block));
-        }
+
+    std::vector<Block> blocks(CHUNK_VOLUME);
+    std::vector<std::pair<ChunkPos, std::vector<u8>>> payloads;
+    for (int i = 0; i < count; i++) {
+        ChunkPos pos;
+        file.read(reinterpret_cast<char*>(&pos), sizeof(ChunkPos));
+        file.read(reinterpret_cast<char*>(blocks.data()), CHUNK_VOLUME * sizeof(Block));
+        if (!file) break;
+
+        payloads.emplace_back(pos, std::vector<u8>());
+        ChunkCodec::encode(blocks.data(), payloads.back().second);
     }
-    
     file.close();
-    
-    LOG_INFO("Saved world '" + worldName + "' with " + std::to_string(savedCount) + " modified chunks.");
-    return true;
+
+    int migrated = storage.writeChunks(payloads) ? static_cast<int>(payloads.size()) : 0;
+    if (migrated == count) {
+        // Keep the old file around instead of deleting it
+        std::error_code ec;
+        fs::rename(chunksFile, chunksFile + ".migrated", ec);
+    }
+    LOG_INFO("Migrated " + std::to_string(migrated) + " chunks from chunks.dat to region files.");
 }
 
 bool WorldSerializer::loadWorld(const std::string& worldName, ChunkManager& chunkManager, glm::vec3& playerPos, long& seed) {
@@ -89,34 +111,10 @@ bool WorldSerializer::loadWorld(const std::string& worldName, ChunkManager& chun
         levelFile.close();
     }
     
-    // Load chunks from single file
-    std::string chunksFile = worldDir + "/chunks.dat";
-    if (fs::exists(chunksFile)) {
-        std::ifstream file(chunksFile, std::ios::binary);
-        if (file.is_open()) {
-            uint32_t magic;
-            uint32_t version;
-            int count;
-            
-            file.read(reinterpret_cast<char*>(&magic), sizeof(uint32_t));
-            file.read(reinterpret_cast<char*>(&version), sizeof(uint32_t));
-            file.read(reinterpret_cast<char*>(&count), sizeof(int));
-            
-            if (magic == 0x4D434350 && version == 1) {
-                for (int i = 0; i < count; i++) {
-                    ChunkPos pos;
-                    file.read(reinterpret_cast<char*>(&pos), sizeof(ChunkPos));
-                    
-                    std::vector<Block> blocks(CHUNK_VOLUME);
-                    file.read(reinterpret_cast<char*>(blocks.data()), CHUNK_VOLUME * sizeof(Block));
-                    
-                    chunkManager.preloadChunkData(pos, blocks);
-                }
-                LOG_INFO("Loaded " + std::to_string(count) + " chunks from disk.");
-            }
-            file.close();
-        }
-    }
+    // Chunks are read from the regions when they are generated
+    auto storage = openRegionStorage(worldName, false);
+    migrateLegacyChunks(worldDir, *storage);
+    chunkManager.setRegionStorage(storage);
     
     return true;
 }
@@ -1,17 +1,31 @@
 #pragma once
 
 #include "ChunkManager.h"
+#include "RegionFile.h"
+#include <memory>
 #include <string>
 #include <vector>
 
+// Worlds live in saves/<name>/: level.dat (player position, seed) plus one region
+// file per REGION_SIZE^3 chunks in region/, payloads encoded with ChunkCodec.
+// Saving is done by AutosaveService (only chunks with unsaved edits are written);
+// loading reads level.dat and chunks are read on demand (ChunkManager::loadSavedChunk)
+// as the world streams in.
 class WorldSerializer {
 public:
-    static bool saveWorld(const std::string& worldName, const ChunkManager& chunkManager, const glm::vec3& playerPos, long seed);
+    static bool saveLevel(const std::string& worldName, const glm::vec3& playerPos, long seed); // Atomic replace
     static bool loadWorld(const std::string& worldName, ChunkManager& chunkManager, glm::vec3& playerPos, long& seed);
     static std::vector<std::string> getAvailableWorlds();
     static bool createNewWorld(const std::string& worldName, long seed);
-    
+
+    // Region storage for a world; fresh discards any existing regions on first save
+    static std::shared_ptr<RegionStorage> openRegionStorage(const std::string& worldName, bool fresh);
+    static std::string getRegionDirectory(const std::string& worldName);
+
 private:
     static std::string getSaveDirectory();
     static std::string getWorldDirectory(const std::string& worldName);
+
+    // Moves a version 1 chunks.dat into region files
+    static void migrateLegacyChunks(const std::string& worldDir, RegionStorage& storage);
 };
@@ -6,19 +6,23 @@
 #include "Core/Settings.h"
 #include "Render/Renderer.h"
 #include "Render/Camera.h"
+#include "World/BlockAccessor.h"
 #include "World/ChunkManager.h"
 #include "World/WorldGenerator.h"
 #include "Mesh/MeshBuilder.h"
 #include "Util/Config.h"
 #include "UI/UIManager.h"
 #include "World/WorldSerializer.h"
+#include "World/AutosaveService.h"
 #include "Entity/PlayerEntity.h"
 #include "Entity/ZombieEntity.h"
 
 #include <memory>
 #include <iostream>
 #include <mutex>
+#include <atomic>
 #include <vector>
+#include <tuple>
 #include <ctime>
 #include <cstdlib>
 
@@ -27,6 +31,7 @@ public:
     Application() 
         : camera(glm::vec3(0.0f, 80.0f, 0.0f)),
           threadPool(THREAD_POOL_SIZE),
+          autosave(chunkManager),
           lastX(0.0), lastY(0.0), lastSpaceTime(0.0), firstMouse(true),
           running(true) {
     }
@@ -140,8 +145,12 @@ public:
         });
         
         uiManager.setOnSave([this]() {
-            WorldSerializer::saveWorld(currentWorldName, chunkManager, camera.getPosition(), currentSeed);
-            LOG_INFO("Game Saved");
+            if (autosave.requestSave(currentWorldName, camera.getPosition(), currentSeed)) {
+                autosaveTimer = 0.0f;
+                LOG_INFO("Saving game...");
+            } else {
+                LOG_INFO("A save is already in progress");
+            }
         });
         
         uiManager.setOnExit([this]() {
@@ -170,11 +179,7 @@ public:
                 chunkManager.requestChunkGeneration(pos);
                 auto chunk = chunkManager.getChunk(pos);
                 if (chunk) {
-                    if (chunkManager.hasPreloadedData(pos)) {
-                        auto blocks = chunkManager.getPreloadedData(pos);
-                        std::copy(blocks.begin(), blocks.end(), chunk->getBlocks().begin());
-                        chunk->setModified(true);
-                    } else {
+                    if (!chunkManager.loadSavedChunk(chunk)) {
                         worldGenerator.generate(chunk);
                     }
                     chunk->setState(ChunkState::MESH_BUILD);
@@ -185,11 +190,10 @@ public:
             int meshed = 0;
             for (auto& chunk : chunksToMesh) {
                 if (meshed > 200) break; // cap work this frame to avoid massive hitch; still much faster than falling through
-                auto neighbors = chunkManager.getNeighbors(chunk->getPosition());
-                MeshData meshData = meshBuilder.buildChunkMesh(chunk,
-                    neighbors[0], neighbors[1], neighbors[2], neighbors[3], neighbors[4], neighbors[5], chunk->getCurrentLOD());
+                MeshData meshData = meshBuilder.buildChunkMesh(chunkManager.getNeighborhood(chunk->getPosition()), chunk->getCurrentLOD());
 
-                renderer.uploadChunkMesh(chunk->getPosition(), meshData.vertices, meshData.indices, meshData.waterVertices, meshData.waterIndices);
+                renderer.uploadChunkMesh(chunk->getPosition(), meshData);
+                meshBuilder.recycle(std::move(meshData));
                 chunk->setState(ChunkState::GPU_UPLOADED);
                 meshed++;
             }
@@ -201,6 +205,8 @@ public:
         
         // Give UIManager access to world generator for map
         uiManager.setWorldGenerator(&worldGenerator);
+        // ... and ChunkManager for the column extents that keep sky / deep stone implicit
+        chunkManager.setWorldGenerator(&worldGenerator);
         
         // Apply initial settings
         applySettings();
@@ -221,11 +227,16 @@ public:
         // Set seed
         worldGenerator.setSeed(static_cast<unsigned int>(seed));
         
-        // Clear existing world
+        // Clear existing world (a save still writing the previous one finishes first)
+        autosave.waitIdle();
+        autosaveTimer = 0.0f;
         chunkManager.unloadAll();
-        chunkManager.clear(); // Clear preloaded data too
+        chunkManager.clear(); // Clear unsaved chunk data too
         renderer.clear(); // Clear GPU buffers from previous world
         
+        // A new world replaces any saved world of the same name once it's saved
+        chunkManager.setRegionStorage(WorldSerializer::openRegionStorage(currentWorldName, true));
+        
         // Find a safe spawn location (Land)
         // If (0,0) is ocean, search outwards until we find land.
         int spawnX = 0;
@@ -283,24 +294,13 @@ public:
                     chunkManager.requestChunkGeneration(pos);
                     auto chunk = chunkManager.getChunk(pos);
                     if (chunk) {
-                        // Check if we have preloaded data
-                        if (chunkManager.hasPreloadedData(pos)) {
-                            auto blocks = chunkManager.getPreloadedData(pos);
-                            std::copy(blocks.begin(), blocks.end(), chunk->getBlocks().begin());
-                            chunk->setModified(true); // Mark as modified so it saves again
-                        } else {
+                        // Saved chunks are read from their region file, the rest is generated
+                        if (!chunkManager.loadSavedChunk(chunk)) {
                             worldGenerator.generate(chunk);
                         }
                         
+                        // Neighbors generated before this one are re-meshed by getChunksToMesh
                         chunk->setState(ChunkState::MESH_BUILD);
-                        
-                        // Mark neighbors for update to ensure no gaps
-                        auto neighbors = chunkManager.getNeighbors(pos);
-                        for (auto& n : neighbors) {
-                            if (n && n->getState() != ChunkState::UNLOADED) {
-                                n->setState(ChunkState::MESH_BUILD);
-                            }
-                        }
                     }
                     generated++;
                     
@@ -328,14 +328,10 @@ public:
                 initialLoadDone = true;
             } else {
                 for (auto& chunk : chunksToMesh) {
-                    auto neighbors = chunkManager.getNeighbors(chunk->getPosition());
-                    
-                    MeshData meshData = meshBuilder.buildChunkMesh(chunk, 
-                        neighbors[0], neighbors[1], neighbors[2], neighbors[3], neighbors[4], neighbors[5], chunk->getCurrentLOD());
+                    MeshData meshData = meshBuilder.buildChunkMesh(chunkManager.getNeighborhood(chunk->getPosition()), chunk->getCurrentLOD());
                         
-                    renderer.uploadChunkMesh(chunk->getPosition(), 
-                        meshData.vertices, meshData.indices, 
-                        meshData.waterVertices, meshData.waterIndices);
+                    renderer.uploadChunkMesh(chunk->getPosition(), meshData);
+                    meshBuilder.recycle(std::move(meshData));
                         
                     chunk->setState(ChunkState::GPU_UPLOADED);
                     meshedCount++;
@@ -389,7 +385,9 @@ public:
     bool loadWorld(const std::string& name = "world.dat") {
         LOG_INFO("Loading world: " + name);
         
-        // Clear existing world
+        // Clear existing world (a save still writing the previous one finishes first)
+        autosave.waitIdle();
+        autosaveTimer = 0.0f;
         chunkManager.unloadAll();
         chunkManager.clear();
         
@@ -499,6 +497,63 @@ public:
                 LOG_INFO("FPS: " + std::to_string(Time::instance().getFPS()));
                 fpsTimer = 0.0f;
             }
+
+            // Log resident chunk memory every 10 seconds
+            static float memoryTimer = 0.0f;
+            memoryTimer += deltaTime;
+            if (memoryTimer >= 10.0f) {
+                size_t chunkCount = chunkManager.getChunks().size();
+                LOG_INFO("Chunks: " + std::to_string(chunkCount) + ", block storage: " +
+                         std::to_string(chunkManager.getBlockMemoryUsage() / 1024) + " KB (dense: " +
+                         std::to_string(chunkCount * CHUNK_VOLUME * sizeof(Block) / 1024) + " KB)");
+                LOG_INFO("Uniform chunks skipped - mesh (air): " + std::to_string(meshBuilder.getUniformAirSkipped()) +
+                         ", mesh (enclosed): " + std::to_string(meshBuilder.getEnclosedSolidSkipped()) +
+                         ", fluid scan: " + std::to_string(uniformFluidScansSkipped.load()) +
+                         ", render (last frame): " + std::to_string(renderer.getUniformChunksSkipped()));
+                LOG_INFO("Back-face groups - indices drawn (last frame): " + std::to_string(renderer.getIndicesDrawn()) +
+                         " of " + std::to_string(renderer.getIndicesTotal()));
+                size_t perChunkIndexBytes = renderer.getPerChunkIndexBytes();
+                size_t sharedIndexBytes = renderer.getSharedIndexBytes();
+                LOG_INFO("Chunk index memory - shared quad buffer: " + std::to_string(sharedIndexBytes / 1024) +
+                         " KB, per-chunk buffers would take: " + std::to_string(perChunkIndexBytes / 1024) + " KB (saved " +
+                         std::to_string((perChunkIndexBytes > sharedIndexBytes ? perChunkIndexBytes - sharedIndexBytes : 0) / 1024) + " KB)");
+                LOG_INFO("Mesh buffers - pooled: " + std::to_string(meshBuilder.getPooledBuffers()) +
+                         ", fresh: " + std::to_string(meshBuilder.getFreshBuffers()) +
+                         ", grown past hint: " + std::to_string(meshBuilder.getBufferGrowths()));
+                LOG_INFO("Incremental re-meshes: " + std::to_string(meshBuilder.getIncrementalBuilds()) +
+                         ", slices re-meshed: " + std::to_string(meshBuilder.getSlicesRebuilt()) +
+                         ", slices reused: " + std::to_string(meshBuilder.getSlicesReused()));
+                const ChunkManager::MeshScheduleStats& scheduleStats = chunkManager.getMeshScheduleStats();
+                LOG_INFO("Mesh scheduling - waited for neighbors: " + std::to_string(scheduleStats.deferred) +
+                         ", rebuilds avoided: " + std::to_string(scheduleStats.rebuildsAvoided) +
+                         ", timed out: " + std::to_string(scheduleStats.timeouts) +
+                         ", neighbor re-meshes: " + std::to_string(scheduleStats.neighborRebuilds));
+                const ChunkJobScheduler& jobScheduler = chunkManager.getJobScheduler();
+                LOG_INFO("Chunk jobs - pending: " + std::to_string(jobScheduler.getPendingCount()) +
+                         ", in flight: " + std::to_string(jobScheduler.getInFlightCount()) +
+                         ", dropped: " + std::to_string(jobScheduler.getDroppedCount()) +
+                         ", failed: " + std::to_string(jobScheduler.getFailedCount()));
+                ChunkPool::Stats poolStats = chunkManager.getChunkPool().getStats();
+                LOG_INFO("Chunk pool - live: " + std::to_string(poolStats.live) + " (peak " +
+                         std::to_string(poolStats.highWater) + "), free: " + std::to_string(poolStats.free) +
+                         ", reused: " + std::to_string(poolStats.reused) + " of " + std::to_string(poolStats.acquired) + " acquires");
+                const ChunkManager::ImplicitChunkStats& implicitStats = chunkManager.getImplicitChunkStats();
+                LOG_INFO("Implicit chunks - skipped: " + std::to_string(implicitStats.skipped) +
+                         ", materialized: " + std::to_string(implicitStats.materialized));
+                ChunkManager::EvictionStats evictionStats = chunkManager.getEvictionStats();
+                LOG_INFO("Chunk memory - resident: " + std::to_string(evictionStats.residentBytes / (1024 * 1024)) +
+                         " MB of " + std::to_string(Settings::instance().chunkMemoryBudgetMB) + " MB budget, parked: " +
+                         std::to_string(evictionStats.parked) + ", evicted: " + std::to_string(evictionStats.evicted) +
+                         ", revived: " + std::to_string(evictionStats.revived));
+                AutosaveService::Stats saveStats = autosave.getStats();
+                LOG_INFO("Autosave - saves: " + std::to_string(saveStats.savesCompleted) +
+                         " (failed " + std::to_string(saveStats.savesFailed) + "), chunks written: " +
+                         std::to_string(saveStats.chunksWritten) + " (" + std::to_string(saveStats.bytesWritten / 1024) +
+                         " KB), last: " + std::to_string(saveStats.lastSaveMs) + " ms (snapshot " +
+                         std::to_string(saveStats.lastSnapshotMs) + " ms), max: " + std::to_string(saveStats.maxSaveMs) +
+                         " ms" + (saveStats.busy ? ", in progress " + std::to_string(static_cast<int>(autosave.getProgress() * 100.0f)) + "%" : ""));
+                memoryTimer = 0.0f;
+            }
         }
         
         LOG_INFO("Application shutting down");
@@ -514,9 +569,12 @@ private:
     ThreadPool threadPool;
     UIManager uiManager;
     WorldSerializer worldSerializer;
+    AutosaveService autosave; // After chunkManager: its I/O thread is stopped first
+    float autosaveTimer = 0.0f;
     
     std::mutex meshMutex;
-    std::vector<std::pair<ChunkPos, MeshData>> pendingMeshes;
+    std::vector<std::tuple<ChunkPos, ChunkHandle, MeshData>> pendingMeshes;
+    std::atomic<u64> uniformFluidScansSkipped{0};
 
     double lastX, lastY;
     double lastSpaceTime;
@@ -537,6 +595,7 @@ private:
         camera.setSensitivity(s.mouseSensitivity);
         window->setVSync(s.vsync);
         window->setFullscreen(s.fullscreen);
+        meshBuilder.setAlgorithm(s.binaryMeshing ? MeshingAlgorithm::BINARY : MeshingAlgorithm::GREEDY);
         // Render distance is handled in ChunkManager::update
         // AO and Gamma are handled in Renderer::render
     }
@@ -801,6 +860,15 @@ private:
             playerEntity->update(deltaTime);
         }
 
+        // Periodic background save; skipped (retried next frame) while the last one is still writing
+        if (playerEntity) {
+            autosaveTimer += deltaTime;
+            if (autosaveTimer >= AUTOSAVE_INTERVAL_SECONDS &&
+                autosave.requestSave(currentWorldName, camera.getPosition(), currentSeed)) {
+                autosaveTimer = 0.0f;
+            }
+        }
+
         // === Zombies ===
         // Spawn a few around the player over time (simple, deterministic-ish)
         zombieSpawnTimer -= deltaTime;
@@ -844,27 +912,29 @@ private:
             if (chunk && chunk->getState() == ChunkState::UNLOADED) {
                 chunk->setState(ChunkState::GENERATING);
                 
-                // Generate in thread pool
-                threadPool.enqueue([this, chunk]() {
-                    if (chunkManager.hasPreloadedData(chunk->getPosition())) {
-                        auto blocks = chunkManager.getPreloadedData(chunk->getPosition());
-                        std::copy(blocks.begin(), blocks.end(), chunk->getBlocks().begin());
-                        chunk->setModified(true);
-                    } else {
+                // Generate in thread pool (ordered/cancelled by the chunk job scheduler)
+                chunkManager.getJobScheduler().schedule(chunk, ChunkJobType::GENERATE, [this, chunk]() {
+                    if (!chunkManager.loadSavedChunk(chunk)) {
                         worldGenerator.generate(chunk);
                     }
                     
-                    // Scan for water to initialize fluid simulation
-                    for (int x = 0; x < CHUNK_SIZE; ++x) {
-                        for (int y = 0; y < CHUNK_HEIGHT; ++y) {
-                            for (int z = 0; z < CHUNK_SIZE; ++z) {
-                                if (chunk->getBlock(x, y, z).getType() == BlockType::WATER) {
-                                    glm::vec3 worldPos = ChunkManager::chunkToWorld(chunk->getPosition());
-                                    chunkManager.scheduleFluidUpdate(
-                                        static_cast<int>(worldPos.x) + x,
-                                        static_cast<int>(worldPos.y) + y,
-                                        static_cast<int>(worldPos.z) + z
-                                    );
+                    // Scan for water to initialize fluid simulation. Fluid updates only act on
+                    // water, so a uniform chunk of anything else has nothing to schedule.
+                    Block uniform;
+                    if (chunk->getUniformBlock(uniform) && uniform.getType() != BlockType::WATER) {
+                        uniformFluidScansSkipped++;
+                    } else {
+                        for (int x = 0; x < CHUNK_SIZE; ++x) {
+                            for (int y = 0; y < CHUNK_HEIGHT; ++y) {
+                                for (int z = 0; z < CHUNK_SIZE; ++z) {
+                                    if (chunk->getBlock(x, y, z).getType() == BlockType::WATER) {
+                                        glm::vec3 worldPos = ChunkManager::chunkToWorld(chunk->getPosition());
+                                        chunkManager.scheduleFluidUpdate(
+                                            static_cast<int>(worldPos.x) + x,
+                                            static_cast<int>(worldPos.y) + y,
+                                            static_cast<int>(worldPos.z) + z
+                                        );
+                                    }
                                 }
                             }
                         }
@@ -880,44 +950,49 @@ private:
         for (auto chunk : chunksToMesh) {
             chunk->setState(ChunkState::READY);
             
-            // Get neighbors for greedy meshing
-            const ChunkPos& pos = chunk->getPosition();
-            auto chunkXPos = chunkManager.getChunk(pos + ChunkPos(1, 0, 0));
-            auto chunkXNeg = chunkManager.getChunk(pos + ChunkPos(-1, 0, 0));
-            auto chunkYPos = chunkManager.getChunk(pos + ChunkPos(0, 1, 0));
-            auto chunkYNeg = chunkManager.getChunk(pos + ChunkPos(0, -1, 0));
-            auto chunkZPos = chunkManager.getChunk(pos + ChunkPos(0, 0, 1));
-            auto chunkZNeg = chunkManager.getChunk(pos + ChunkPos(0, 0, -1));
+            // Neighbors (faces, edges and corners) for greedy meshing and seam AO are gathered
+            // by the job; implicit stone can only be looked up here
+            u32 implicitSolid = chunkManager.getImplicitSolidNeighbors(chunk->getPosition());
             
             int lod = chunk->getCurrentLOD();
 
-            threadPool.enqueue([this, chunk, chunkXPos, chunkXNeg, chunkYPos, chunkYNeg, chunkZPos, chunkZNeg, lod]() {
-                auto meshData = meshBuilder.buildChunkMesh(chunk, chunkXPos, chunkXNeg, chunkYPos, chunkYNeg, chunkZPos, chunkZNeg, lod);
+            auto meshJob = [this, chunk, implicitSolid, lod]() {
+                auto meshData = meshBuilder.buildChunkMesh(chunkManager.getNeighborhood(chunk->getPosition(), implicitSolid), lod);
                 
                 std::lock_guard<std::mutex> lock(meshMutex);
-                pendingMeshes.emplace_back(chunk->getPosition(), std::move(meshData));
-            });
+                pendingMeshes.emplace_back(chunk->getPosition(), chunk->getHandle(), std::move(meshData));
+            };
+            static_assert(Job::fitsInline<decltype(meshJob)>(), "mesh jobs must not allocate");
+
+            // Meshes go ahead of generation in the pool: they're what the player actually sees next
+            chunkManager.getJobScheduler().schedule(chunk, ChunkJobType::MESH, std::move(meshJob));
         }
 
+        // Hand the closest / most visible chunk jobs to the workers
+        chunkManager.getJobScheduler().dispatch(threadPool);
+
         // Upload meshes
         {
             std::lock_guard<std::mutex> lock(meshMutex);
-            for (auto& [pos, meshData] : pendingMeshes) {
+            for (auto& [pos, handle, meshData] : pendingMeshes) {
+                // Unloaded while it was meshed, and maybe loaded again since (pooled chunks get a
+                // new handle): the mesh belongs to a chunk that is gone
+                auto chunk = chunkManager.getChunk(pos);
+                if (!chunk || chunk->getHandle() != handle) {
+                    meshBuilder.recycle(std::move(meshData));
+                    continue;
+                }
                 if (!meshData.isEmpty()) {
-                    renderer.uploadChunkMesh(pos, meshData.vertices, meshData.indices, meshData.waterVertices, meshData.waterIndices);
-                    auto chunk = chunkManager.getChunk(pos);
-                    if (chunk) {
-                        chunk->setState(ChunkState::GPU_UPLOADED);
-                    }
+                    renderer.uploadChunkMesh(pos, meshData);
+                    chunk->setState(ChunkState::GPU_UPLOADED);
                 } else {
                     // Empty mesh (e.g. air chunk), but still mark as processed
-                    auto chunk = chunkManager.getChunk(pos);
-                    if (chunk) {
-                        chunk->setState(ChunkState::GPU_UPLOADED);
-                    }
+                    chunk->setState(ChunkState::GPU_UPLOADED);
                     // Ensure we clear any existing mesh for this chunk
-                    renderer.uploadChunkMesh(pos, {}, {}, {}, {});
+                    renderer.uploadChunkMesh(pos, MeshData{});
                 }
+                // The GPU has its copy; the buffers go back to the meshers
+                meshBuilder.recycle(std::move(meshData));
             }
             pendingMeshes.clear();
         }
@@ -967,9 +1042,10 @@ private:
         // Check if in water
         bool inWater = false;
         glm::vec3 camPos = camera.getPosition();
+        BlockAccessor blocks(chunkManager);
         // Check eye level and feet level
-        Block headBlock = chunkManager.getBlockAt(static_cast<int>(floor(camPos.x)), static_cast<int>(floor(camPos.y)), static_cast<int>(floor(camPos.z)));
-        Block feetBlock = chunkManager.getBlockAt(static_cast<int>(floor(camPos.x)), static_cast<int>(floor(camPos.y - 1.5f)), static_cast<int>(floor(camPos.z)));
+        Block headBlock = blocks.getBlock(static_cast<int>(floor(camPos.x)), static_cast<int>(floor(camPos.y)), static_cast<int>(floor(camPos.z)));
+        Block feetBlock = blocks.getBlock(static_cast<int>(floor(camPos.x)), static_cast<int>(floor(camPos.y - 1.5f)), static_cast<int>(floor(camPos.z)));
         
         if (headBlock.isWater() || feetBlock.isWater()) {
             inWater = true;
@@ -1013,21 +1089,21 @@ private:
         glm::vec3 vel = camera.velocity * deltaTime;
         
         // Try X movement
-        if (checkCollision(glm::vec3(pos.x + vel.x, pos.y, pos.z))) {
+        if (checkCollision(blocks, glm::vec3(pos.x + vel.x, pos.y, pos.z))) {
             vel.x = 0;
             camera.velocity.x = 0;
         }
         pos.x += vel.x;
         
         // Try Z movement
-        if (checkCollision(glm::vec3(pos.x, pos.y, pos.z + vel.z))) {
+        if (checkCollision(blocks, glm::vec3(pos.x, pos.y, pos.z + vel.z))) {
             vel.z = 0;
             camera.velocity.z = 0;
         }
         pos.z += vel.z;
         
         // Try Y movement
-        if (checkCollision(glm::vec3(pos.x, pos.y + vel.y, pos.z))) {
+        if (checkCollision(blocks, glm::vec3(pos.x, pos.y + vel.y, pos.z))) {
             if (vel.y < 0) camera.onGround = true;
             vel.y = 0;
             camera.velocity.y = 0;
@@ -1043,7 +1119,7 @@ private:
         // ...
     }
     
-    bool checkCollision(const glm::vec3& pos) {
+    bool checkCollision(BlockAccessor& blocks, const glm::vec3& pos) {
         float minX = pos.x - 0.3f;
         float maxX = pos.x + 0.3f;
         float minY = pos.y - 1.6f;
@@ -1051,15 +1127,8 @@ private:
         float minZ = pos.z - 0.3f;
         float maxZ = pos.z + 0.3f;
         
-        for (int x = static_cast<int>(floor(minX)); x <= static_cast<int>(floor(maxX)); x++) {
-            for (int y = static_cast<int>(floor(minY)); y <= static_cast<int>(floor(maxY)); y++) {
-                for (int z = static_cast<int>(floor(minZ)); z <= static_cast<int>(floor(maxZ)); z++) {
-                    Block block = chunkManager.getBlockAt(x, y, z);
-                    if (block.isSolid()) return true;
-                }
-            }
-        }
-        return false;
+        return blocks.anySolid(glm::ivec3(static_cast<int>(floor(minX)), static_cast<int>(floor(minY)), static_cast<int>(floor(minZ))),
+                               glm::ivec3(static_cast<int>(floor(maxX)), static_cast<int>(floor(maxY)), static_cast<int>(floor(maxZ))));
     }
 };
 